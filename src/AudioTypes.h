@@ -0,0 +1,277 @@
+#pragma once
+#ifndef SINEKIT_AUDIOTYPES_H
+#define SINEKIT_AUDIOTYPES_H
+
+#include "lib/BufferPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sk {
+
+enum class AudioType { Undefined, PCM, DSD };
+
+// The low byte of each depth is its word width in bits; I32 sets bit 8 to
+// tell it apart from F32.
+enum class BitType : std::uint16_t {
+    Undefined = 0,
+    // 1‑bit DSD, kept in the 8‑bit buffer eight samples to a byte.
+    D1 = 1,
+    // Unsigned, offset binary (128 is silence), as 8‑bit WAV stores it.
+    I8 = 8,
+    I16 = 16,
+    I24 = 24,
+    I32 = 0x120,
+    F32 = 32,
+    F64 = 64
+};
+
+// Bits in one sample word of bitType, as file headers count them.
+[[nodiscard]] constexpr std::uint16_t
+bitsPerSample(BitType bitType) noexcept {
+    return static_cast<std::uint16_t>(bitType) & 0xFF;
+}
+
+// Depth of a PCM payload as its header describes it: `bits` per sample
+// word and whether the words are IEEE floats.  Every reader maps headers
+// through here; a combination SineKit does not hold (8‑ to 24‑bit float,
+// 64‑bit integer, ...) is Undefined.
+[[nodiscard]] constexpr BitType pcmBitType(unsigned bits,
+                                           bool isFloat) noexcept {
+    if (isFloat)
+        return bits == 32 ? BitType::F32
+               : bits == 64 ? BitType::F64
+                            : BitType::Undefined;
+    switch (bits) {
+    case 8:
+        return BitType::I8;
+    case 16:
+        return BitType::I16;
+    case 24:
+        return BitType::I24;
+    case 32:
+        return BitType::I32;
+    default:
+        return BitType::Undefined;
+    }
+}
+
+enum class SampleRate : std::uint32_t {
+    Undefined = 0,
+    P22K05 = 22050,
+    P32K = 32000,
+    P44K1 = 44100,
+    P48K = 48000,
+    P88K2 = 88200,
+    P96K = 96000,
+    P176K4 = 176400,
+    P192K = 192000,
+    DSD64 = 2822400,
+    DSD128 = 5644800,
+    DSD256 = 11289600,
+    DSD512 = 22579200
+};
+
+enum class WindowType : std::uint32_t {
+    RECTANGULAR = 0,
+    HAMMING = 1,
+    HANNING = 2,
+    BLACKMAN = 3,
+    KAISER = 4,
+};
+
+enum class InterpolationOrder : std::uint8_t {
+    Default = 3,
+    Linear = 1,
+    Quadratic = 2,
+    Cubic = 3,
+    Quartic = 4,
+    Sinc = 5
+};
+// Peak of the triangular (TPDF) dither added when reducing to a narrower
+// integer depth: Low ±0.5 LSB, Medium ±1 LSB (the usual choice, which
+// fully decorrelates the error from the signal), High ±1.5 LSB.
+enum class DitherAmount { None, Low, Medium, High };
+// Error feedback filter applied with dither.  FirstOrder moves the noise
+// towards Nyquist at any rate; EWeighted (Lipshitz et al., 5 taps) and
+// FWeighted (Wannamaker, 9 taps) follow the ear's threshold and are
+// designed for 44.1 / 48 kHz.
+enum class NoiseShaping { None, FirstOrder, EWeighted, FWeighted };
+// Sample rate conversion filter.  Standard is flat to 0.44 × the lower rate
+// with 100 dB of alias rejection; High is flat to 0.475 with 140 dB (about
+// 3.5 times the taps).  Both are Kaiser windowed sincs.
+enum class ResampleQuality { Standard, High };
+
+// ── Planar sample storage ────────────────────────────────────────────────
+// All channels live in one 64‑byte aligned allocation drawn from sk::pool.
+// Each channel starts on a cache line: its stride is numFrames() rounded up
+// to a whole line, and the padding is kept zero so vector kernels may read
+// a full register past the last frame.  resize() reuses the allocation
+// whenever it is big enough.
+template <typename T> class AudioBuffer {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "AudioBuffer holds plain samples");
+
+  public:
+    static constexpr std::size_t kAlignment = pool::kAlignment;
+
+    AudioBuffer() = default;
+    AudioBuffer(std::size_t numChannels, std::size_t numFrames) {
+        resize(numChannels, numFrames);
+    }
+    AudioBuffer(const AudioBuffer &other) { *this = other; }
+    AudioBuffer(AudioBuffer &&other) noexcept { swap(other); }
+    AudioBuffer &operator=(const AudioBuffer &other) {
+        if (this != &other) {
+            reshape(other.Channels_, other.Frames_);
+            if (size() > 0)
+                std::memcpy(Data_.get(), other.Data_.get(),
+                            size() * sizeof(T));
+        }
+        return *this;
+    }
+    AudioBuffer &operator=(AudioBuffer &&other) noexcept {
+        AudioBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    // numChannels × numFrames zeroed samples.
+    void resize(std::size_t numChannels, std::size_t numFrames) {
+        reshape(numChannels, numFrames);
+        if (size() > 0)
+            std::memset(Data_.get(), 0, size() * sizeof(T));
+    }
+    // The same shape, but only the padding is zeroed; for callers that
+    // write every sample straight away.
+    void resizeForOverwrite(std::size_t numChannels, std::size_t numFrames) {
+        reshape(numChannels, numFrames);
+        for (std::size_t c = 0; c < numChannels; ++c)
+            std::memset(Data_.get() + c * Stride_ + numFrames, 0,
+                        (Stride_ - numFrames) * sizeof(T));
+    }
+    [[nodiscard]] std::size_t numChannels() const noexcept {
+        return Channels_;
+    }
+    [[nodiscard]] std::size_t numFrames() const noexcept { return Frames_; }
+    // Distance in samples from one channel to the next.
+    [[nodiscard]] std::size_t stride() const noexcept { return Stride_; }
+
+    [[nodiscard]] std::span<T> channel(std::size_t c) noexcept {
+        return {Data_.get() + c * Stride_, Frames_};
+    }
+    [[nodiscard]] std::span<const T> channel(std::size_t c) const noexcept {
+        return {Data_.get() + c * Stride_, Frames_};
+    }
+
+    T &operator()(std::size_t c, std::size_t f) noexcept {
+        return Data_[c * Stride_ + f];
+    }
+    const T &operator()(std::size_t c, std::size_t f) const noexcept {
+        return Data_[c * Stride_ + f];
+    }
+
+    // Drop the samples and release the allocation.
+    void clear() noexcept { AudioBuffer().swap(*this); }
+
+    // Samples the current allocation can hold.
+    [[nodiscard]] std::size_t capacity() const noexcept { return Capacity_; }
+    // The stride a buffer of numFrames frames uses.
+    [[nodiscard]] static constexpr std::size_t
+    strideFor(std::size_t numFrames) noexcept {
+        constexpr std::size_t line =
+            kAlignment >= sizeof(T) ? kAlignment / sizeof(T) : 1;
+        return (numFrames + line - 1) / line * line;
+    }
+
+    // Hand the allocation over to a buffer of U samples with the same shape,
+    // leaving this one empty.  Nothing is converted: the memory keeps its
+    // bytes for the caller to rewrite.  Throws if the allocation is too
+    // small for the new stride.
+    template <typename U> [[nodiscard]] AudioBuffer<U> reuseAs() && {
+        const std::size_t bytes = Capacity_ * sizeof(T);
+        AudioBuffer<U> out;
+        const std::size_t stride = AudioBuffer<U>::strideFor(Frames_);
+        if (Channels_ * stride * sizeof(U) > bytes)
+            throw std::runtime_error("allocation too small to reuse");
+        out.Data_.reset(static_cast<U *>(static_cast<void *>(Data_.release())));
+        out.Capacity_ = bytes / sizeof(U);
+        out.Channels_ = Channels_;
+        out.Frames_ = Frames_;
+        out.Stride_ = stride;
+        clear();
+        return out;
+    }
+
+    template <typename U> friend class AudioBuffer;
+
+    void swap(AudioBuffer &other) noexcept {
+        std::swap(Data_, other.Data_);
+        std::swap(Capacity_, other.Capacity_);
+        std::swap(Channels_, other.Channels_);
+        std::swap(Frames_, other.Frames_);
+        std::swap(Stride_, other.Stride_);
+    }
+
+  private:
+    struct Free {
+        void operator()(T *p) const noexcept { pool::release(p); }
+    };
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return Channels_ * Stride_;
+    }
+
+    // Set the shape, growing the allocation if needed; contents are left
+    // unspecified.
+    void reshape(std::size_t numChannels, std::size_t numFrames) {
+        const std::size_t stride = strideFor(numFrames);
+        const std::size_t needed = numChannels * stride;
+        if (needed > Capacity_) {
+            // Hand the old block back first; it may serve this request.
+            clear();
+            const auto block = pool::allocate(needed * sizeof(T));
+            Data_.reset(static_cast<T *>(static_cast<void *>(block.data())));
+            Capacity_ = block.size() / sizeof(T);
+        }
+        Channels_ = numChannels;
+        Frames_ = numFrames;
+        Stride_ = stride;
+    }
+
+    std::unique_ptr<T[], Free> Data_;
+    std::size_t Capacity_{0};
+    std::size_t Channels_{0};
+    std::size_t Frames_{0};
+    std::size_t Stride_{0};
+};
+
+// Invoke fn(std::type_identity<T>{}) with the in‑memory sample type used for
+// bitType, so callers can dispatch a generic lambda once per buffer instead
+// of once per sample.
+template <typename Fn>
+decltype(auto) withSampleType(BitType bitType, Fn &&fn) {
+    switch (bitType) {
+    case BitType::I8:
+        return fn(std::type_identity<std::uint8_t>{});
+    case BitType::I16:
+        return fn(std::type_identity<std::int16_t>{});
+    case BitType::I24:
+    case BitType::I32:
+        return fn(std::type_identity<std::int32_t>{});
+    case BitType::F32:
+        return fn(std::type_identity<float>{});
+    case BitType::F64:
+        return fn(std::type_identity<double>{});
+    default:
+        throw std::runtime_error("unsupported bit depth");
+    }
+}
+
+} // namespace sk
+
+#endif // SINEKIT_AUDIOTYPES_H
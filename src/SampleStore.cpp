@@ -0,0 +1,95 @@
+#include "SampleStore.h"
+
+#include "dsp/BitDepth.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+
+// Samples staged per step of an in‑place conversion.
+constexpr std::size_t kStageSamples = 1024;
+
+// Convert src, laid out with srcStride, into dst, which shares its memory.
+// Each block is copied out before the destination is written, so a block
+// may overlap its own source.  Narrowing (or equal) words never reach
+// further than the source already read when walked forwards; widening ones
+// are walked backwards for the same reason.
+template <typename From, typename To>
+std::size_t convertInPlace(std::byte *base, std::size_t srcStride,
+                           std::size_t dstStride, std::size_t channels,
+                           std::size_t frames, sk::dsp::Converter convert) {
+    std::array<From, kStageSamples> stage;
+    std::array<To, kStageSamples> out;
+    std::size_t clipped = 0;
+    auto block = [&](std::size_t c, std::size_t f0, std::size_t n) {
+        std::memcpy(stage.data(), base + (c * srcStride + f0) * sizeof(From),
+                    n * sizeof(From));
+        clipped += convert(stage.data(), out.data(), n);
+        std::memcpy(base + (c * dstStride + f0) * sizeof(To), out.data(),
+                    n * sizeof(To));
+    };
+    // Channel padding must end up zero; it may hold stale source bytes.
+    auto pad = [&](std::size_t c) {
+        std::memset(base + (c * dstStride + frames) * sizeof(To), 0,
+                    (dstStride - frames) * sizeof(To));
+    };
+
+    if constexpr (sizeof(To) <= sizeof(From)) {
+        for (std::size_t c = 0; c < channels; ++c) {
+            for (std::size_t f0 = 0; f0 < frames; f0 += kStageSamples)
+                block(c, f0, std::min(kStageSamples, frames - f0));
+            pad(c);
+        }
+    } else {
+        for (std::size_t c = channels; c-- > 0;) {
+            for (std::size_t end = frames; end > 0;) {
+                const std::size_t n = std::min(kStageSamples, end);
+                end -= n;
+                block(c, end, n);
+            }
+            pad(c);
+        }
+    }
+    return clipped;
+}
+
+} // namespace
+
+std::size_t sk::SampleStore::convert(BitType from, BitType to) {
+    if (from == to)
+        return 0;
+    // The kernel is chosen once; every block then runs it directly.
+    const sk::dsp::Converter kernel = sk::dsp::converter(from, to);
+    std::size_t clipped = 0;
+    withSampleType(from, [&]<typename From>(std::type_identity<From>) {
+        withSampleType(to, [&]<typename To>(std::type_identity<To>) {
+            AudioBuffer<From> &src = get<From>();
+            const std::size_t channels = src.numChannels();
+            const std::size_t frames = src.numFrames();
+            const std::size_t stride = AudioBuffer<To>::strideFor(frames);
+
+            if (channels * stride * sizeof(To) >
+                src.capacity() * sizeof(From)) {
+                // Widening beyond the allocation: one fresh buffer, filled
+                // straight from the source, which is then released.
+                AudioBuffer<To> dst;
+                dst.resizeForOverwrite(channels, frames);
+                for (std::size_t c = 0; c < channels; ++c)
+                    clipped += kernel(src.channel(c).data(),
+                                      dst.channel(c).data(), frames);
+                assign(std::move(dst));
+                return;
+            }
+
+            const std::size_t srcStride = src.stride();
+            auto *base = reinterpret_cast<std::byte *>(src.channel(0).data());
+            AudioBuffer<To> dst = std::move(src).template reuseAs<To>();
+            if (channels > 0)
+                clipped = convertInPlace<From, To>(base, srcStride, stride,
+                                                   channels, frames, kernel);
+            assign(std::move(dst));
+        });
+    });
+    return clipped;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef SINEKIT_SAMPLESTORE_H
+#define SINEKIT_SAMPLESTORE_H
+
+#include "AudioTypes.h"
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+namespace sk {
+
+// ── The one buffer SineKit keeps its samples in ──────────────────────────
+// Holds a single AudioBuffer of whichever sample type is current, so only
+// one copy of the audio exists at a time.  Depth conversions reuse the
+// allocation in place whenever the new word is no wider than the old one
+// (or the allocation happens to be big enough); only a widening conversion
+// that does not fit allocates, and it then frees the source as soon as the
+// copy is done.
+class SampleStore {
+  public:
+    [[nodiscard]] bool empty() const noexcept {
+        return std::holds_alternative<std::monostate>(Buffer_);
+    }
+
+    // The buffer, which must currently hold T samples.
+    template <typename T> [[nodiscard]] AudioBuffer<T> &get() {
+        if (auto *buffer = std::get_if<AudioBuffer<T>>(&Buffer_))
+            return *buffer;
+        throw std::runtime_error("sample store holds another sample type");
+    }
+    template <typename T> [[nodiscard]] const AudioBuffer<T> &get() const {
+        if (auto *buffer = std::get_if<AudioBuffer<T>>(&Buffer_))
+            return *buffer;
+        throw std::runtime_error("sample store holds another sample type");
+    }
+
+    // Switch to an empty buffer of T samples, releasing the old one.
+    template <typename T> AudioBuffer<T> &emplace() {
+        return Buffer_.template emplace<AudioBuffer<T>>();
+    }
+    template <typename T> void assign(AudioBuffer<T> &&buffer) {
+        Buffer_.template emplace<AudioBuffer<T>>(std::move(buffer));
+    }
+
+    // Call fn with the current buffer, whatever its sample type.
+    template <typename Fn> decltype(auto) visit(Fn &&fn) {
+        return std::visit(
+            [&](auto &buffer) -> decltype(auto) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(buffer)>,
+                                             std::monostate>)
+                    throw std::runtime_error("no samples loaded");
+                else
+                    return fn(buffer);
+            },
+            Buffer_);
+    }
+    template <typename Fn> decltype(auto) visit(Fn &&fn) const {
+        return std::visit(
+            [&](const auto &buffer) -> decltype(auto) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(buffer)>,
+                                             std::monostate>)
+                    throw std::runtime_error("no samples loaded");
+                else
+                    return fn(buffer);
+            },
+            Buffer_);
+    }
+
+    // Convert every sample from the `from` depth to the `to` depth with the
+    // dsp::converter kernel for the pair, in place where the allocation
+    // allows.  Returns the number of samples clipped.
+    std::size_t convert(BitType from, BitType to);
+
+    void clear() noexcept { Buffer_.emplace<std::monostate>(); }
+
+  private:
+    std::variant<std::monostate, AudioBuffer<std::uint8_t>,
+                 AudioBuffer<std::int16_t>, AudioBuffer<std::int32_t>,
+                 AudioBuffer<float>, AudioBuffer<double>>
+        Buffer_;
+};
+
+} // namespace sk
+
+#endif // SINEKIT_SAMPLESTORE_H
@@ -1,512 +1,273 @@
 #include "SineKit.h"
 
-void sk::SineKit::clearBut(sk::BitType bitType) {
-    switch (bitType) {
-    case BitType::I8: {
-        // Buffer8I_.clear();
-        Buffer16I_.clear();
-        Buffer24I_.clear();
-        Buffer32I_.clear();
-        Buffer32F_.clear();
-        Buffer64F_.clear();
-        break;
-    }
-    case BitType::I16: {
-        Buffer8I_.clear();
-        // Buffer16I_.clear();
-        Buffer24I_.clear();
-        Buffer32I_.clear();
-        Buffer32F_.clear();
-        Buffer64F_.clear();
-        break;
-    }
-    case BitType::I24: {
-        Buffer8I_.clear();
-        Buffer16I_.clear();
-        // Buffer24I_.clear();
-        Buffer32I_.clear();
-        Buffer32F_.clear();
-        Buffer64F_.clear();
-        break;
-    }
-    case BitType::F32: {
-        Buffer8I_.clear();
-        Buffer16I_.clear();
-        Buffer24I_.clear();
-        Buffer32I_.clear();
-        // Buffer32F_.clear();
-        Buffer64F_.clear();
-        break;
-    }
-    case BitType::F64: {
-        Buffer8I_.clear();
-        Buffer16I_.clear();
-        Buffer24I_.clear();
-        Buffer32I_.clear();
-        Buffer32F_.clear();
-        // Buffer64F_.clear();
-        break;
-    }
-    default:
-        break;
-    }
-}
-
-template <typename T> void sk::AudioBuffer<T>::clear() { channels.clear(); }
-
 void sk::SineKit::updateHeaders() {
-    WAVHeader_.update(static_cast<std::uint16_t>(BitType_),
+    WAVHeader_.update(bitsPerSample(BitType_),
                       static_cast<uint32_t>(SampleRate_), NumChannels_,
                       NumFrames_,
                       (BitType_ == BitType::F32 || BitType_ == BitType::F64));
-    AIFFHeader_.update(static_cast<std::uint16_t>(BitType_),
+    AIFFHeader_.update(bitsPerSample(BitType_),
                        static_cast<uint32_t>(SampleRate_), NumChannels_,
                        NumFrames_,
                        (BitType_ == BitType::F32 || BitType_ == BitType::F64));
 }
 
 template <typename T>
-void sk::SineKit::readInterleaved(std::ifstream &in, AudioBuffer<T> &dst,
+void sk::SineKit::readInterleaved(const std::filesystem::path &path,
+                                  std::uint64_t offset, AudioBuffer<T> &dst,
                                   std::size_t frames, std::size_t ch,
                                   sk::endian::Endian fileEndian,
                                   sk::BitType bitType) {
-    dst.resize(ch, frames);
-
-    if (bitType == sk::BitType::I24) {
-        std::array<std::uint8_t, 3> trip{};
-        for (std::size_t f = 0; f < frames; ++f) {
-            for (std::size_t c = 0; c < ch; ++c) {
-                in.read(reinterpret_cast<char *>(trip.data()), 3);
-                if (!in)
-                    throw std::runtime_error("PCM payload short (24‑bit read)");
-
-                std::uint32_t v32;
-                if (fileEndian == sk::endian::Endian::Little) {
-                    v32 = (static_cast<std::uint32_t>(trip[2]) << 16) |
-                          (static_cast<std::uint32_t>(trip[1]) << 8) |
-                          (static_cast<std::uint32_t>(trip[0]));
-                } else {
-                    v32 = (static_cast<std::uint32_t>(trip[0]) << 16) |
-                          (static_cast<std::uint32_t>(trip[1]) << 8) |
-                          (static_cast<std::uint32_t>(trip[2]));
-                }
-
-                if (v32 & 0x00800000)
-                    v32 |= 0xFF000000;
-                dst(c, f) = static_cast<std::int32_t>(v32);
-            }
-        }
-    } else {
-        // Other formats: read directly as tightly packed interleaved data
-        std::vector<T> inter(frames * ch);
-        in.read(reinterpret_cast<char *>(inter.data()),
-                static_cast<std::streamsize>(inter.size() * sizeof(T)));
-        if (!in)
-            throw std::runtime_error("PCM payload short");
-
-        for (auto &v : inter) {
-            if constexpr (sizeof(T) != 1) {
-                v = (fileEndian == sk::endian::Endian::Little)
-                        ? sk::endian::le_to_host(v)
-                        : sk::endian::be_to_host(v);
-            }
-        }
-
-        for (std::size_t f = 0; f < frames; ++f)
-            for (std::size_t c = 0; c < ch; ++c)
-                dst(c, f) = inter[f * ch + c];
+    const std::size_t width = (bitType == sk::BitType::I24) ? 3 : sizeof(T);
+    dst.resizeForOverwrite(ch, frames);
+    std::vector<T *> planes(ch);
+
+    // Samples are decoded straight from each I/O block into their channel;
+    // the reader already has the next block in flight meanwhile.
+    sk::io::BlockReader reader(path, offset, std::uint64_t{frames} * ch * width,
+                               ch * width);
+    std::size_t f0 = 0;
+    for (auto block = reader.next(); !block.empty(); block = reader.next()) {
+        const std::size_t n = block.size() / (ch * width);
+        for (std::size_t c = 0; c < ch; ++c)
+            planes[c] = dst.channel(c).data() + f0;
+        sk::pcm::decode(block.data(), planes.data(), n, ch, fileEndian, width);
+        f0 += n;
     }
 }
 
 template <typename T>
-void sk::SineKit::writeInterleaved(std::ofstream &out,
+void sk::SineKit::writeInterleaved(const std::filesystem::path &path,
+                                   std::uint64_t offset,
                                    const AudioBuffer<T> &src,
                                    std::size_t frames, std::size_t ch,
                                    sk::endian::Endian fileEndian,
                                    sk::BitType bitType) {
-
-    if (bitType == sk::BitType::I24) {
-        std::array<std::uint8_t, 3> trip{};
-        for (std::size_t f = 0; f < frames; ++f) {
-            for (std::size_t cdx = 0; cdx < ch; ++cdx) {
-                auto s = static_cast<std::uint32_t>(src(cdx, f));
-                if (fileEndian == sk::endian::Endian::Little) {
-                    trip[0] = s & 0xFF;
-                    trip[1] = (s >> 8) & 0xFF;
-                    trip[2] = (s >> 16) & 0xFF;
-                } else {
-                    trip[2] = s & 0xFF;
-                    trip[1] = (s >> 8) & 0xFF;
-                    trip[0] = (s >> 16) & 0xFF;
-                }
-                out.write(reinterpret_cast<char *>(trip.data()), 3);
-            }
-        }
-    } else {
-        std::vector<T> inter(frames * ch);
-        for (std::size_t f = 0; f < frames; ++f)
-            for (std::size_t cdx = 0; cdx < ch; ++cdx)
-                inter[f * ch + cdx] = src(cdx, f);
-
-        for (auto &v : inter) {
-            if constexpr (sizeof(T) != 1) {
-                v = sk::endian::host_to_file(v, fileEndian);
-            }
-        }
-
-        out.write(reinterpret_cast<const char *>(inter.data()),
-                  static_cast<std::streamsize>(inter.size() * sizeof(T)));
+    const std::size_t width = (bitType == sk::BitType::I24) ? 3 : sizeof(T);
+    std::vector<const T *> planes(ch);
+
+    // Encode into one block while the previous one is being written.
+    sk::io::BlockWriter writer(path, offset);
+    for (std::size_t f0 = 0; f0 < frames;) {
+        const auto block = writer.buffer();
+        const std::size_t n =
+            std::min(block.size() / (ch * width), frames - f0);
+        for (std::size_t c = 0; c < ch; ++c)
+            planes[c] = src.channel(c).data() + f0;
+        sk::pcm::encode(planes.data(), block.data(), n, ch, fileEndian, width);
+        writer.commit(n * ch * width);
+        f0 += n;
     }
+    // RIFF and IFF chunks are word aligned.
+    if ((frames * ch * width) & 1) {
+        writer.buffer()[0] = 0;
+        writer.commit(1);
+    }
+    writer.finish();
 }
 
 // ─── Public API ───────────────────────────────────────────────────────────
 void sk::SineKit::loadFile(const std::filesystem::path &input_path) {
-    std::ifstream file(input_path, std::ios::binary);
-    if (!file)
-        throw std::runtime_error("open " + input_path.string());
+    // DSD is kept as is; NumFrames_ counts 1‑bit samples.
+    auto loadDSD = [&](auto &&reader) {
+        AudioType_ = AudioType::DSD;
+        BitType_ = BitType::D1;
+        SampleRate_ = reader.sampleRate();
+        NumChannels_ = reader.numChannels();
+        NumFrames_ = reader.numSamples();
+        reader.readAll(Samples_.emplace<std::uint8_t>());
+    };
+    if (input_path.extension() == ".dsf")
+        return loadDSD(sk::io::DSFReader(input_path));
+    if (input_path.extension() == ".dff")
+        return loadDSD(sk::io::DSDIFFReader(input_path));
+
+    sk::io::MappedFile file(input_path);
+    sk::bytes::ByteReader bytes(file.data(), file.size());
+    sk::endian::Endian fileEndian;
+
     if (input_path.extension() == ".wav") {
-        WAVHeader_.read(file);
+        WAVHeader_.read(bytes);
 
         NumChannels_ = WAVHeader_.fmt.NumChannels;
         SampleRate_ = static_cast<SampleRate>(WAVHeader_.fmt.SampleRate);
-        BitType_ = static_cast<BitType>(WAVHeader_.fmt.BitsPerSample);
-        NumFrames_ = WAVHeader_.data.Subchunk2Size / WAVHeader_.fmt.BlockAlign;
-
-        switch (BitType_) {
-        case BitType::I16:
-            readInterleaved(file, Buffer16I_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Little, BitType_);
-            break;
-        case BitType::I24:
-            readInterleaved(file, Buffer24I_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Little, BitType_);
-            break;
-        case BitType::F32:
-            readInterleaved(file, Buffer32F_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Little, BitType_);
-            break;
-        case BitType::F64:
-            readInterleaved(file, Buffer64F_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Little, BitType_);
-            break;
-        default:
-            throw std::runtime_error("unsupported depth");
-        }
-        updateHeaders();
+        BitType_ = pcmBitType(WAVHeader_.fmt.BitsPerSample,
+                              WAVHeader_.isFloat());
+        NumFrames_ = WAVHeader_.numFrames();
+        fileEndian = sk::endian::Endian::Little;
     } else if (input_path.extension() == ".aiff") {
-        AIFFHeader_.read(file);
+        AIFFHeader_.read(bytes);
 
         NumChannels_ = AIFFHeader_.comm.NumChannels;
         SampleRate_ = static_cast<SampleRate>(
             static_cast<std::uint32_t>(AIFFHeader_.comm.SampleRate));
-        BitType_ = static_cast<BitType>(AIFFHeader_.comm.BitDepth);
+        BitType_ = pcmBitType(
+            static_cast<unsigned>(AIFFHeader_.comm.BitDepth),
+            AIFFHeader_.isFloat());
+        // 8‑bit AIFF is signed; SineKit keeps 8‑bit samples unsigned.
+        if (BitType_ == BitType::I8)
+            throw std::runtime_error("8-bit audio must be WAV");
         NumFrames_ = AIFFHeader_.comm.NumSamples;
-
-        switch (BitType_) {
-        case BitType::I16:
-            readInterleaved(file, Buffer16I_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Big, BitType_);
-            break;
-        case BitType::I24:
-            readInterleaved(file, Buffer24I_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Big, BitType_);
-            break;
-        case BitType::F32:
-            readInterleaved(file, Buffer32F_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Big, BitType_);
-            break;
-        case BitType::F64:
-            readInterleaved(file, Buffer64F_, NumFrames_, NumChannels_,
-                            sk::endian::Endian::Big, BitType_);
-            break;
-        default:
-            throw std::runtime_error("unsupported depth");
-        }
-        updateHeaders();
+        fileEndian = AIFFHeader_.byteOrder();
+    } else {
+        throw std::runtime_error("unsupported container " +
+                                 input_path.extension().string());
     }
+    AudioType_ = AudioType::PCM;
+
+    // Both readers leave the cursor on the first payload byte.  The mapping
+    // only serves the header; the payload is streamed by readInterleaved.
+    const std::uint64_t payload = bytes.tell();
+    const std::size_t width =
+        BitType_ == BitType::I24 ? 3 : bitsPerSample(BitType_) / 8;
+    if (NumFrames_ * NumChannels_ * width > bytes.remaining())
+        throw std::runtime_error("PCM payload short");
     file.close();
+
+    withSampleType(BitType_, [&]<typename T>(std::type_identity<T>) {
+        readInterleaved(input_path, payload, Samples_.emplace<T>(), NumFrames_,
+                        NumChannels_, fileEndian, BitType_);
+    });
+    updateHeaders();
 }
 
 void sk::SineKit::writeFile(const std::filesystem::path &output_path) const {
-    std::ofstream file(output_path, std::ios::binary);
-    if (!file)
-        throw std::runtime_error("create " + output_path.string());
-
-    if (output_path.extension() == ".wav") {
-        WAVHeader_.write(file);
-
-        switch (BitType_) {
-        case BitType::I16:
-            writeInterleaved(file, Buffer16I_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Little, BitType_);
-            break;
-        case BitType::I24:
-            writeInterleaved(file, Buffer24I_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Little, BitType_);
-            break;
-        case BitType::F32:
-            writeInterleaved(file, Buffer32F_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Little, BitType_);
-            break;
-        case BitType::F64:
-            writeInterleaved(file, Buffer64F_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Little, BitType_);
-            break;
-        default:
-            assert(false);
-        }
-    } else if (output_path.extension() == ".aiff") {
-        AIFFHeader_.write(file);
-
-        switch (BitType_) {
-        case BitType::I16:
-            writeInterleaved(file, Buffer16I_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Big, BitType_);
-            break;
-        case BitType::I24:
-            writeInterleaved(file, Buffer24I_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Big, BitType_);
-            break;
-        case BitType::F32:
-            writeInterleaved(file, Buffer32F_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Big, BitType_);
-            break;
-        case BitType::F64:
-            writeInterleaved(file, Buffer64F_, NumFrames_, NumChannels_,
-                             sk::endian::Endian::Big, BitType_);
-            break;
-        default:
-            assert(false);
-        }
+    const bool dsdFile = output_path.extension() == ".dsf" ||
+                         output_path.extension() == ".dff";
+    if (AudioType_ == AudioType::DSD) {
+        if (!dsdFile)
+            throw std::runtime_error(
+                "DSD audio can only be written as DSF or DSDIFF");
+        auto writeDSD = [&](auto &&writer) {
+            writer.write(Samples_.get<std::uint8_t>(), NumFrames_);
+            writer.close();
+        };
+        if (output_path.extension() == ".dsf")
+            writeDSD(sk::io::DSFWriter(output_path, SampleRate_, NumChannels_));
+        else
+            writeDSD(
+                sk::io::DSDIFFWriter(output_path, SampleRate_, NumChannels_));
+        return;
     }
-    file.close();
+    if (dsdFile)
+        throw std::runtime_error("DSF and DSDIFF output need DSD audio");
+    // SineKit keeps 8‑bit samples unsigned, as WAV does; AIFF's are signed.
+    if (BitType_ == BitType::I8 && output_path.extension() == ".aiff")
+        throw std::runtime_error("8-bit audio can only be written as WAV");
+
+    sk::endian::Endian fileEndian;
+    std::uint64_t offset;
+    {
+        std::ofstream file(output_path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("create " + output_path.string());
+
+        if (output_path.extension() == ".wav") {
+            WAVHeader_.write(file);
+            fileEndian = sk::endian::Endian::Little;
+        } else if (output_path.extension() == ".aiff") {
+            AIFFHeader_.write(file);
+            fileEndian = AIFFHeader_.byteOrder();
+        } else {
+            throw std::runtime_error("unsupported container " +
+                                     output_path.extension().string());
+        }
+        offset = static_cast<std::uint64_t>(file.tellp());
+        file.close();
+        if (!file)
+            throw std::runtime_error("header write failed " +
+                                     output_path.string());
+    }
+
+    Samples_.visit([&](const auto &buffer) {
+        writeInterleaved(output_path, offset, buffer, NumFrames_, NumChannels_,
+                         fileEndian, BitType_);
+    });
 }
 
-void sk::SineKit::toBitDepth(BitType bitType) {
+void sk::SineKit::toBitDepth(BitType bitType, DitherAmount dither,
+                             NoiseShaping shaping) {
+    if (AudioType_ == AudioType::DSD)
+        throw std::runtime_error("convert DSD with toPCM first");
+    Clipped_ = 0;
     if (bitType == BitType_)
         return;
-    switch (bitType) {
-    case BitType::I16: {
-        switch (BitType_) {
-        case BitType::I16:
-            break;
-        case BitType::I24: {
-            Buffer16I_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer16I_.channels.at(j).at(i) = static_cast<int16_t>(
-                        Buffer24I_.channels.at(j).at(i) >> 8);
-                }
-            }
-
-            BitType_ = BitType::I16;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::F32: {
-            Buffer16I_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    float sample = Buffer32F_.channels.at(j).at(i);
-                    if (sample > 1.0f)
-                        sample = 1.0f;
-                    if (sample < -1.0f)
-                        sample = -1.0f;
-                    Buffer16I_.channels.at(j).at(i) =
-                        static_cast<int16_t>(sample * 32767.0f);
-                }
-            }
-            BitType_ = BitType::I16;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::F64: {
-            Buffer16I_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    double sample = Buffer64F_.channels.at(j).at(i);
-                    if (sample > 1.0)
-                        sample = 1.0;
-                    if (sample < -1.0)
-                        sample = -1.0;
-                    Buffer16I_.channels.at(j).at(i) =
-                        static_cast<int16_t>(sample * 32767.0);
+    if ((dither != DitherAmount::None || shaping != NoiseShaping::None) &&
+        sk::dsp::Dither::applies(BitType_, bitType)) {
+        // The error feedback is serial within a channel; a ditherer runs
+        // kLanes channels in lockstep, and the groups go to threads.  The
+        // narrower target is a separate buffer.
+        auto requantise = [&]<typename From, typename To>(
+                              std::type_identity<From>,
+                              std::type_identity<To>) {
+            constexpr std::size_t lanes = sk::dsp::Dither::kLanes;
+            const AudioBuffer<From> &source = Samples_.get<From>();
+            AudioBuffer<To> target;
+            target.resizeForOverwrite(NumChannels_, NumFrames_);
+            const std::size_t groups = (NumChannels_ + lanes - 1) / lanes;
+            std::vector<std::uint64_t> clipped(groups);
+            sk::parallel::forEach(groups, [&](std::size_t g) {
+                const std::size_t first = g * lanes;
+                const std::size_t count =
+                    std::min<std::size_t>(lanes, NumChannels_ - first);
+                std::vector<const From *> in(count);
+                std::vector<To *> out(count);
+                for (std::size_t c = 0; c < count; ++c) {
+                    in[c] = source.channel(first + c).data();
+                    out[c] = target.channel(first + c).data();
                 }
-            }
-            BitType_ = BitType::I16;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        default:
-            throw std::runtime_error("unsupported bit depth conversion");
-        }
-        break;
-    }
-    case BitType::I24: {
-        switch (BitType_) {
-        case BitType::I24:
-            break;
-        case BitType::I16: {
-            Buffer24I_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer24I_.channels.at(j).at(i) =
-                        static_cast<int32_t>(Buffer16I_.channels.at(j).at(i))
-                        << 8;
-                }
-            }
-            BitType_ = BitType::I24;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::F32: {
-            Buffer24I_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    float sample = Buffer32F_.channels.at(j).at(i);
-                    if (sample > 1.0f)
-                        sample = 1.0f;
-                    if (sample < -1.0f)
-                        sample = -1.0f;
-                    Buffer24I_.channels.at(j).at(i) =
-                        static_cast<int32_t>(sample * 8388607.0f);
-                }
-            }
-            BitType_ = BitType::I24;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::F64: {
-            Buffer24I_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    double sample = Buffer64F_.channels.at(j).at(i);
-                    if (sample > 1.0)
-                        sample = 1.0;
-                    if (sample < -1.0)
-                        sample = -1.0;
-                    Buffer24I_.channels.at(j).at(i) =
-                        static_cast<int32_t>(sample * 8388607.0);
-                }
-            }
-            BitType_ = BitType::I24;
-            updateHeaders();
-            clearBut(BitType_);
-            break;
-        }
-        default:
-            throw std::runtime_error("unsupported bit depth conversion");
-        }
-        break;
-    }
-    case BitType::F32: {
-        switch (BitType_) {
-        case BitType::F32:
-            break;
-        case BitType::I16: {
-            Buffer32F_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer32F_.channels.at(j).at(i) =
-                        static_cast<float>(Buffer16I_.channels.at(j).at(i)) /
-                        32767.0f;
-                }
-            }
-            BitType_ = BitType::F32;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::I24: {
-            Buffer32F_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer32F_.channels.at(j).at(i) =
-                        static_cast<float>(Buffer24I_.channels.at(j).at(i)) /
-                        8388607.0f;
-                }
-            }
-            BitType_ = BitType::F32;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::F64: {
-            Buffer32F_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer32F_.channels.at(j).at(i) =
-                        static_cast<float>(Buffer64F_.channels.at(j).at(i));
-                }
-            }
-            BitType_ = BitType::F32;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        default:
-            throw std::runtime_error("unsupported bit depth conversion");
-        }
-        break;
-    }
-    case BitType::F64: {
-        switch (BitType_) {
-        case BitType::F64:
-            break;
-        case BitType::I16: {
-            Buffer64F_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer64F_.channels.at(j).at(i) =
-                        static_cast<double>(Buffer16I_.channels.at(j).at(i)) /
-                        32767.0;
-                }
-            }
-            BitType_ = BitType::F64;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::I24: {
-            Buffer64F_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer64F_.channels.at(j).at(i) =
-                        static_cast<double>(Buffer24I_.channels.at(j).at(i)) /
-                        8388607.0;
-                }
-            }
-            BitType_ = BitType::F64;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        case BitType::F32: {
-            Buffer64F_.resize(NumChannels_, NumFrames_);
-            for (int i = 0; i < NumFrames_; i++) {
-                for (int j = 0; j < NumChannels_; j++) {
-                    Buffer64F_.channels.at(j).at(i) =
-                        static_cast<double>(Buffer32F_.channels.at(j).at(i));
-                }
-            }
-            BitType_ = BitType::F64;
-            clearBut(BitType_);
-            updateHeaders();
-            break;
-        }
-        default:
-            throw std::runtime_error("unsupported bit depth conversion");
-        }
-        break;
-    }
-    default:
-        throw std::runtime_error("unsupported bit depth conversion");
+                sk::dsp::Dither ditherer(dither, shaping, count,
+                                         static_cast<std::uint32_t>(first));
+                clipped[g] = ditherer.process(in.data(), out.data(),
+                                              NumFrames_, BitType_, bitType);
+            });
+            Samples_.assign(std::move(target));
+            Clipped_ = 0;
+            for (const std::uint64_t n : clipped)
+                Clipped_ += n;
+        };
+        withSampleType(BitType_, [&](auto from) {
+            withSampleType(bitType,
+                           [&](auto to) { requantise(from, to); });
+        });
+    } else {
+        // Narrowing and same‑width conversions happen inside the existing
+        // allocation, so the audio is never held twice.
+        Clipped_ = Samples_.convert(BitType_, bitType);
     }
+    BitType_ = bitType;
+    updateHeaders();
+}
+
+template <typename T>
+sk::AudioBuffer<T> sk::SineKit::resampleChannels(
+    const sk::dsp::Resampler &resampler, const AudioBuffer<T> &buffer,
+    std::size_t frames, std::size_t ch, sk::BitType bitType) {
+    const std::uint64_t outFrames = resampler.outputLength(frames);
+    const int bits = bitsPerSample(bitType);
+    const double zero = bitType == BitType::I8 ? 128 : 0;
+    const double clampMax = std::ldexp(1.0, bits - 1) - 1;
+    const double clampMin = -clampMax - 1;
+
+    AudioBuffer<T> target;
+    target.resizeForOverwrite(ch, outFrames);
+    sk::parallel::forEach(ch, [&](std::size_t c) {
+        std::vector<double, sk::pool::Allocator<double>> in(frames);
+        std::vector<double, sk::pool::Allocator<double>> out(outFrames);
+        const T *src = buffer.channel(c).data();
+        for (std::size_t j = 0; j < frames; j++)
+            in[j] = static_cast<double>(src[j]) - zero;
+        resampler.run(in.data(), frames, out.data());
+        T *dst = target.channel(c).data();
+        for (std::uint64_t j = 0; j < outFrames; j++) {
+            if constexpr (std::is_floating_point_v<T>)
+                dst[j] = static_cast<T>(out[j]);
+            else
+                dst[j] = static_cast<T>(
+                    std::clamp(std::round(out[j]), clampMin, clampMax) +
+                    zero);
+        }
+    });
+    return target;
 }
 
 template <typename T>
@@ -514,11 +275,9 @@ void sk::SineKit::upsample(std::uint8_t scale, std::uint8_t interpolation,
                            sk::AudioBuffer<T> &buffer, sk::BitType bitType,
                            std::uint64_t windowSize,
                            sk::WindowType windowType) {
-    std::int64_t uFrames = NumFrames_ * scale;
-    AudioBuffer<T> tempBuffer;
-    tempBuffer.resize(NumChannels_, uFrames);
-    long double clampMin = 0;
-    long double clampMax = 0;
+    const std::uint64_t uFrames = NumFrames_ * scale;
+    double clampMin = 0;
+    double clampMax = 0;
     switch (bitType) {
     case BitType::I8:
         clampMin = 0;
@@ -532,159 +291,65 @@ void sk::SineKit::upsample(std::uint8_t scale, std::uint8_t interpolation,
         clampMin = -8388608;
         clampMax = 8388607;
         break;
-    default:
+    case BitType::I32:
+        clampMin = -2147483648.0;
+        clampMax = 2147483647;
         break;
+    case BitType::F32:
+    case BitType::F64:
+        break;
+    default:
+        throw std::runtime_error(
+            "unsupported bit type called into upsample()");
     }
+    // Interpolated integer words are rounded and clamped to their range.
+    auto store = [&](double v) {
+        if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(v);
+        else
+            return static_cast<T>(
+                std::clamp(std::round(v), clampMin, clampMax));
+    };
 
-    for (std::int64_t i = 0; i < NumChannels_; i++) {
-        for (std::int64_t j = NumFrames_ - 1; j >= 0; j--) {
-            tempBuffer.channels[i][j * scale] = buffer.channels[i][j];
-        }
-        for (std::int64_t j = 0; j < uFrames; j++) {
-            if (j % scale != 0) {
-                tempBuffer.channels[i][j] = 0;
-            }
-        }
-    }
-
+    AudioBuffer<T> tempBuffer;
     switch (interpolation) {
     case 1: {
-        switch (bitType) {
-        case BitType::I8:
-        case BitType::I16:
-        case BitType::I24: {
-            for (std::int64_t i = 0; i < NumChannels_; i++) {
-                for (std::int64_t j = 0; j < NumFrames_ - 1; j++) {
-                    long double ptAy = tempBuffer.channels.at(i).at(j * scale);
-                    long double ptBy =
-                        tempBuffer.channels.at(i).at((j + 1) * scale);
-                    long double delta =
-                        (ptBy - ptAy) / static_cast<long double>(scale);
-
-                    for (int k = 1; k < scale; k++) {
-                        tempBuffer.channels[i][j * scale + k] = static_cast<T>(
-                            std::clamp(std::round(ptAy + delta * k), clampMin,
-                                       clampMax));
-                    }
-                }
-            }
-            break;
-        }
-        case BitType::F32:
-        case BitType::F64: {
-            for (std::int64_t i = 0; i < NumChannels_; i++) {
-                for (std::int64_t j = 0; j < NumFrames_ - 1; j++) {
-                    long double ptAy = tempBuffer.channels.at(i).at(j * scale);
-                    long double ptBy =
-                        tempBuffer.channels.at(i).at((j + 1) * scale);
-                    long double delta =
-                        (ptBy - ptAy) / static_cast<long double>(scale);
-
-                    for (int k = 1; k < scale; k++) {
-                        tempBuffer.channels[i][j * scale + k] =
-                            static_cast<T>(ptAy + delta * k);
-                    }
+        tempBuffer.resizeForOverwrite(NumChannels_, uFrames);
+        // Straight lines between neighbouring samples; the last one is
+        // followed by silence.
+        for (std::size_t i = 0; i < NumChannels_; i++) {
+            const T *src = buffer.channel(i).data();
+            T *dst = tempBuffer.channel(i).data();
+            for (std::uint64_t j = 0; j < NumFrames_; j++) {
+                const auto ptAy = static_cast<double>(src[j]);
+                dst[j * scale] = src[j];
+                if (j + 1 == NumFrames_) {
+                    std::fill(dst + j * scale + 1, dst + uFrames, T{});
+                    break;
                 }
+                const double delta =
+                    (static_cast<double>(src[j + 1]) - ptAy) / scale;
+                for (int k = 1; k < scale; k++)
+                    dst[j * scale + k] = store(ptAy + delta * k);
             }
-            break;
-        }
-        default:
-            throw std::runtime_error(
-                "unsupported bit type called into upsample()");
         }
         break;
     }
     case 5: {
-        // --- Windowed Sinc LUT Generation ---
-        double beta = 10; // typical value, adjust as needed
-        double denom = boost::math::cyl_bessel_i(0.0, beta);
-
-        auto windowDim = static_cast<std::int64_t>(windowSize);
-        std::int64_t halfSize = (windowDim - 1) / 2;
-        std::vector<long double> sincLUT;
-        sincLUT.resize(windowDim);
-
-        for (std::int64_t k = -halfSize; k <= halfSize; k++) {
-            long double x =
-                static_cast<long double>(k) / static_cast<long double>(scale);
-            long double sinc = (k == 0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
-            long double normPos = static_cast<long double>(k + halfSize) /
-                                  (2.0 * static_cast<long double>(halfSize));
-            long double window = 0.0;
-            switch (windowType) {
-            case WindowType::RECTANGULAR:
-                window = 1.0;
-                break;
-            case WindowType::HAMMING:
-                window = 0.54 - 0.46 * std::cos(2.0 * M_PI * normPos);
-                break;
-            case WindowType::HANNING:
-                window = 0.5 * (1.0 + std::cos(2.0 * M_PI * normPos - M_PI));
-                break;
-            case WindowType::BLACKMAN:
-                window = 0.42 - 0.5 * std::cos(2.0 * M_PI * normPos) +
-                         0.08 * std::cos(4.0 * M_PI * normPos);
-                break;
-            case WindowType::KAISER:
-                long double r = 2.0 * normPos - 1.0;
-                window = boost::math::cyl_bessel_i(
-                             0.0, beta * std::sqrt(1.0 - r * r)) /
-                         denom;
-                break;
-            }
-            sincLUT.at(k + halfSize) = sinc * window;
-        }
-        AudioBuffer<T> bufferCache;
-        bufferCache.resize(NumChannels_, uFrames);
-        bufferCache = tempBuffer;
-        switch (bitType) {
-        case BitType::I8:
-        case BitType::I16:
-        case BitType::I24: {
-            for (std::int64_t i = 0; i < NumChannels_; i++) {
-                for (std::int64_t j = 0; j < uFrames; j++) {
-                    if (j % scale != 0) {
-                        long double interpolated = 0;
-                        for (std::int64_t k = -halfSize; k <= halfSize; k++) {
-                            std::int64_t idx = j + k;
-                            interpolated +=
-                                sincLUT.at(k + halfSize) *
-                                ((idx < 0 || idx >= uFrames)
-                                     ? 0
-                                     : bufferCache.channels[i][idx]);
-                        }
-                        tempBuffer.channels[i][j] = static_cast<T>(std::clamp(
-                            std::round(interpolated), clampMin, clampMax));
-                    }
-                }
-            }
-            break;
-        }
-        case BitType::F32:
-        case BitType::F64: {
-            for (std::int64_t i = 0; i < NumChannels_; i++) {
-                for (std::int64_t j = 0; j < uFrames; j++) {
-                    if (j % scale != 0) {
-                        long double interpolated = 0;
-                        for (std::int64_t k = -halfSize; k <= halfSize; k++) {
-                            std::int64_t idx = j + k;
-                            interpolated +=
-                                sincLUT.at(k + halfSize) *
-                                ((idx < 0 || idx >= uFrames)
-                                     ? 0
-                                     : bufferCache.channels[i][idx]);
-                        }
-                        tempBuffer.channels[i][j] =
-                            static_cast<T>(interpolated);
-                    }
-                }
-            }
-            break;
-        }
-        default:
-            throw std::runtime_error(
-                "unsupported bit type called into upsample()");
-        }
+        // Windowed sinc at the output rate with its zero crossings on the
+        // input samples, which the phase landing on them passes through
+        // unchanged.  The design is shared through the filter cache.
+        sk::dsp::FilterSpec spec;
+        spec.Up = scale;
+        spec.Taps = static_cast<std::uint32_t>(
+            (static_cast<std::int64_t>(windowSize) - 1) / 2 * 2 + 1);
+        spec.Window = windowType;
+        spec.Beta = windowType == WindowType::KAISER ? 10 : 0;
+        spec.Spacing = scale;
+        const auto upsampler =
+            sk::dsp::FilterCache::instance().resampler(spec);
+        tempBuffer = resampleChannels(*upsampler, buffer, NumFrames_,
+                                      NumChannels_, bitType);
         break;
     }
     default:
@@ -692,14 +357,28 @@ void sk::SineKit::upsample(std::uint8_t scale, std::uint8_t interpolation,
             "unsupported interpolation type called into upsample()");
     }
 
-    buffer.resize(NumChannels_, uFrames);
-    buffer = tempBuffer;
-    tempBuffer.clear();
+    buffer = std::move(tempBuffer);
+}
+
+template <typename T>
+void sk::SineKit::resample(std::int64_t base, std::int64_t target,
+                           sk::AudioBuffer<T> &buffer, sk::BitType bitType,
+                           ResampleQuality quality) {
+    const std::int64_t g = std::gcd(base, target);
+    const auto up = static_cast<std::size_t>(target / g);
+    const auto down = static_cast<std::size_t>(base / g);
+    const auto resampler = sk::dsp::FilterCache::instance().resampler(
+        sk::dsp::resamplingSpec(up, down, quality));
+    buffer = resampleChannels(*resampler, buffer, NumFrames_, NumChannels_,
+                              bitType);
 }
 
-void sk::SineKit::toSampleRate(SampleRate sampleRate) {
+void sk::SineKit::toSampleRate(SampleRate sampleRate,
+                               ResampleQuality quality) {
     if (sampleRate == SampleRate_)
         return;
+    if (AudioType_ == AudioType::DSD)
+        throw std::runtime_error("convert DSD with toPCM first");
 
     const auto dst = static_cast<std::uint32_t>(sampleRate);
     const auto src = static_cast<std::uint32_t>(SampleRate_);
@@ -707,41 +386,92 @@ void sk::SineKit::toSampleRate(SampleRate sampleRate) {
     if (src == 0 || dst == 0)
         throw std::runtime_error("unsupported or undefined sample rate");
 
-    /* At the moment we only support *up‑sampling* by an *integer* factor.
-       Down‑sampling or non‑integer ratios will be added later. */
-    if (dst < src || (dst % src) != 0)
-        throw std::runtime_error(
-            "non‑integer or down‑sampling ratios not yet implemented");
-
-    const auto scale = static_cast<std::uint8_t>(dst / src);
-    if (scale == 1)
-        return; // should never happen, but guard anyway.
-
-    /* Upsample the active buffer in-place.  We only need to choose the buffer
-       based on the current BitType_.  This removes a large amount of duplicated
-       code and also means every new sample‑rate that is an integer multiple of
-       the current one “just works.” */
-    switch (BitType_) {
-    case BitType::I8:
-        upsample(scale, 5, Buffer8I_, BitType_, 512, WindowType::KAISER);
-        break;
-    case BitType::I16:
-        upsample(scale, 5, Buffer16I_, BitType_, 512, WindowType::KAISER);
-        break;
-    case BitType::I24:
-        upsample(scale, 5, Buffer24I_, BitType_, 512, WindowType::KAISER);
-        break;
-    case BitType::F32:
-        upsample(scale, 5, Buffer32F_, BitType_, 512, WindowType::KAISER);
-        break;
-    case BitType::F64:
-        upsample(scale, 5, Buffer64F_, BitType_, 512, WindowType::KAISER);
-        break;
-    default:
-        throw std::runtime_error("unsupported bit depth for resampling");
+    if (dst > src && dst % src == 0 &&
+        quality == ResampleQuality::Standard) {
+        /* Upsample the active buffer in-place, whatever its sample type.
+           This removes a large amount of duplicated code and also means
+           every new sample‑rate that is an integer multiple of the current
+           one “just works.” */
+        const auto scale = static_cast<std::uint8_t>(dst / src);
+        Samples_.visit([&](auto &buffer) {
+            upsample(scale, 5, buffer, BitType_, 512, WindowType::KAISER);
+        });
+        NumFrames_ *= scale;
+    } else {
+        Samples_.visit([&](auto &buffer) {
+            resample(src, dst, buffer, BitType_, quality);
+            NumFrames_ = buffer.numFrames();
+        });
     }
+    SampleRate_ = sampleRate;
+    updateHeaders();
+}
 
-    NumFrames_ *= scale;
+void sk::SineKit::toPCM(SampleRate sampleRate, BitType bitType) {
+    if (AudioType_ != AudioType::DSD)
+        throw std::runtime_error("toPCM needs DSD audio");
+    // Every channel gets its own copy of the designed filter chain.
+    const sk::dsp::DSDDecimator design(static_cast<std::uint32_t>(SampleRate_),
+                                       static_cast<std::uint32_t>(sampleRate));
+    const std::uint64_t frames = NumFrames_ / design.ratio();
+
+    const AudioBuffer<std::uint8_t> &dsd = Samples_.get<std::uint8_t>();
+    auto decode = [&]<typename T>(std::type_identity<T>) {
+        AudioBuffer<T> target;
+        target.resizeForOverwrite(NumChannels_, frames);
+        sk::parallel::forEach(NumChannels_, [&](std::size_t c) {
+            sk::dsp::DSDDecimator decimator = design;
+            if constexpr (std::is_same_v<T, float>) {
+                decimator.run(dsd.channel(c).data(), NumFrames_,
+                              target.channel(c).data());
+            } else {
+                std::vector<float, sk::pool::Allocator<float>> pcm(frames);
+                decimator.run(dsd.channel(c).data(), NumFrames_, pcm.data());
+                sk::dsp::convertSamples(pcm.data(), target.channel(c).data(),
+                                        frames, BitType::F32, bitType);
+            }
+        });
+        Samples_.assign(std::move(target));
+    };
+    if (bitType != BitType::I16 && bitType != BitType::I24 &&
+        bitType != BitType::F32 && bitType != BitType::F64)
+        throw std::runtime_error("unsupported bit depth for DSD conversion");
+    withSampleType(bitType, decode);
+
+    AudioType_ = AudioType::PCM;
+    BitType_ = bitType;
     SampleRate_ = sampleRate;
+    NumFrames_ = frames;
     updateHeaders();
 }
+
+void sk::SineKit::toDSD(SampleRate sampleRate) {
+    if (AudioType_ == AudioType::DSD)
+        throw std::runtime_error("audio is already DSD");
+    // Built first: it rejects a rate pair before the samples are touched.
+    const sk::dsp::DSDModulator design(static_cast<std::uint32_t>(SampleRate_),
+                                       static_cast<std::uint32_t>(sampleRate));
+    if (BitType_ != BitType::F32 && BitType_ != BitType::F64)
+        toBitDepth(BitType::F32);
+    const std::uint64_t samples = NumFrames_ * design.ratio();
+
+    AudioBuffer<std::uint8_t> dsd;
+    dsd.resizeForOverwrite(NumChannels_, samples / 8);
+    auto modulate = [&]<typename T>(const AudioBuffer<T> &source) {
+        sk::parallel::forEach(NumChannels_, [&](std::size_t c) {
+            sk::dsp::DSDModulator modulator = design;
+            modulator.run(source.channel(c).data(), NumFrames_,
+                          dsd.channel(c).data());
+        });
+    };
+    if (BitType_ == BitType::F32)
+        modulate(Samples_.get<float>());
+    else
+        modulate(Samples_.get<double>());
+
+    Samples_.assign(std::move(dsd));
+    AudioType_ = AudioType::DSD;
+    BitType_ = BitType::D1;
+    SampleRate_ = sampleRate;
+    NumFrames_ = samples;
+}
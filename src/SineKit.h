@@ -2,11 +2,26 @@
 #ifndef SINEKIT_LIBRARY_H
 #define SINEKIT_LIBRARY_H
 
+#include "AudioTypes.h"
+#include "SampleStore.h"
+#include "dsp/BitDepth.h"
+#include "dsp/DSDDecimator.h"
+#include "dsp/DSDModulator.h"
+#include "dsp/Dither.h"
+#include "dsp/FilterCache.h"
+#include "dsp/Resampler.h"
 #include "headers/AIFFHeaders.h"
 #include "headers/HeaderTags.h"
 #include "headers/WAVHeaders.h"
+#include "io/AsyncIO.h"
+#include "io/DSDIFFStream.h"
+#include "io/DSFStream.h"
+#include "io/MappedFile.h"
+#include "lib/ByteReader.h"
 #include "lib/CustomFloat.h"
 #include "lib/EndianHelpers.h"
+#include "lib/PCMCodec.h"
+#include "lib/Parallel.h"
 #include <bit>
 #include <boost/math/special_functions/bessel.hpp>
 #include <cassert>
@@ -18,6 +33,7 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -28,69 +44,6 @@
 
 namespace sk {
 
-enum class AudioType { Undefined, PCM, DSD };
-
-enum class BitType : std::uint16_t {
-    Undefined = 0,
-    I8 = 8,
-    I16 = 16,
-    I24 = 24,
-    F32 = 32,
-    F64 = 64
-};
-
-enum class SampleRate : std::uint32_t {
-    Undefined = 0,
-    P22K05 = 22050,
-    P32K = 32000,
-    P44K1 = 44100,
-    P48K = 48000,
-    P88K2 = 88200,
-    P96K = 96000,
-    P176K4 = 176400,
-    P192K = 192000,
-    DSD64 = 2822400,
-    DSD128 = 5644800,
-    DSD256 = 11289600,
-    DSD512 = 22579200
-};
-
-enum class WindowType : std::uint32_t {
-    RECTANGULAR = 0,
-    HAMMING = 1,
-    HANNING = 2,
-    BLACKMAN = 3,
-    KAISER = 4,
-};
-
-enum class InterpolationOrder : std::uint8_t {
-    Default = 3,
-    Linear = 1,
-    Quadratic = 2,
-    Cubic = 3,
-    Quartic = 4,
-    Sinc = 5
-};
-enum class DitherAmount { None, Low, Medium, High };
-
-template <typename T> struct AudioBuffer {
-    std::vector<std::vector<T>> channels;
-
-    void resize(std::size_t numChannels, size_t numFrames) {
-        channels.assign(numChannels, std::vector<T>(numFrames));
-    }
-    [[nodiscard]] std::size_t numChannels() const { return channels.size(); };
-    [[nodiscard]] std::size_t numFrames() const {
-        return channels.is_empty() ? 0 : channels.front.size();
-    };
-
-    T &operator()(std::size_t c, std::size_t f) { return channels[c][f]; }
-    const T &operator()(std::size_t c, std::size_t f) const {
-        return channels[c][f];
-    }
-    void clear();
-};
-
 class SineKit {
   private:
     headers::WAV::WAVHeader WAVHeader_;
@@ -99,26 +52,28 @@ class SineKit {
     BitType BitType_{BitType::Undefined};
     SampleRate SampleRate_{SampleRate::Undefined};
     std::uint16_t NumChannels_{0};
-    std::uint32_t NumFrames_{0};
-    AudioBuffer<std::uint8_t> Buffer8I_;
-    AudioBuffer<std::int16_t> Buffer16I_;
-    AudioBuffer<std::int32_t> Buffer24I_;
-    AudioBuffer<std::int32_t> Buffer32I_;
-    AudioBuffer<float> Buffer32F_;
-    AudioBuffer<double> Buffer64F_;
-
+    std::uint64_t NumFrames_{0};
+    // In the sample type of BitType_; DSD (BitType::D1) is kept as one
+    // byte stream per channel in an 8‑bit buffer.
+    SampleStore Samples_;
+    // Samples clipped by the last toBitDepth.
+    std::uint64_t Clipped_{0};
+
+    // Payload I/O goes through sk::io's read‑ahead / write‑behind blocks,
+    // so decoding one block overlaps the transfer of the next.
     template <typename T>
-    static void readInterleaved(std::ifstream &, AudioBuffer<T> &,
+    static void readInterleaved(const std::filesystem::path &path,
+                                std::uint64_t offset, AudioBuffer<T> &,
                                 std::size_t frames, std::size_t ch,
                                 sk::endian::Endian fileEndian,
                                 sk::BitType bitType);
 
     template <typename T>
-    static void writeInterleaved(std::ofstream &, const AudioBuffer<T> &,
+    static void writeInterleaved(const std::filesystem::path &path,
+                                 std::uint64_t offset, const AudioBuffer<T> &,
                                  std::size_t frames, std::size_t ch,
                                  sk::endian::Endian fileEndian,
                                  sk::BitType bitType);
-    void clearBut(sk::BitType bitType);
     void updateHeaders();
 
     template <typename T>
@@ -126,17 +81,55 @@ class SineKit {
                   sk::AudioBuffer<T> &buffer, sk::BitType bitType,
                   std::uint64_t windowSize, sk::WindowType windowType);
 
+    // base → target by the reduced ratio L/M, up or down, through a Kaiser
+    // designed prototype of the given quality.  Only the retained outputs
+    // are computed, so the cost follows the output rate.
     template <typename T>
-    void upsampleNonInt(std::int8_t interpolation, std::int64_t base,
-                        std::int64_t target, sk::AudioBuffer<T> &buffer,
-                        sk::BitType bitType, std::uint64_t windowSize,
-                        sk::WindowType windowType);
+    void resample(std::int64_t base, std::int64_t target,
+                  sk::AudioBuffer<T> &buffer, sk::BitType bitType,
+                  ResampleQuality quality);
+
+    // Every channel through resampler, each on its own thread.  Integer
+    // words are filtered about their zero code, then rounded and clamped.
+    template <typename T>
+    static AudioBuffer<T> resampleChannels(const sk::dsp::Resampler &,
+                                           const AudioBuffer<T> &,
+                                           std::size_t frames, std::size_t ch,
+                                           sk::BitType bitType);
 
   public:
     void loadFile(const std::filesystem::path &input_path);
     void writeFile(const std::filesystem::path &output_path) const;
-    void toBitDepth(BitType bitType);
-    void toSampleRate(SampleRate sampleRate);
+    // Converts between any two of I8, I16, I24, I32, F32 and F64.  Float →
+    // integer conversions clip samples outside [-1, 1]; how many were
+    // clipped is kept for clippedSamples().  Dither and noise shaping apply
+    // when the depth narrows to I16 or I24 (from F32, F64, I32, or I24 to
+    // I16); channels are then requantised in parallel.
+    void toBitDepth(BitType bitType,
+                    DitherAmount dither = DitherAmount::None,
+                    NoiseShaping shaping = NoiseShaping::None);
+    [[nodiscard]] std::uint64_t clippedSamples() const noexcept {
+        return Clipped_;
+    }
+    // Resamples by the ratio of the two rates reduced by their gcd
+    // (44.1k → 48k is 160/147, 192k → 48k is 1/4), channels in parallel.
+    // Downsampling filters out everything above the new Nyquist first.
+    // Integer upsampling at Standard quality uses the 512‑tap windowed
+    // sinc.
+    void toSampleRate(SampleRate sampleRate,
+                      ResampleQuality quality = ResampleQuality::Standard);
+    // Decimate loaded DSD to PCM at sampleRate, which must divide the DSD
+    // rate by 8 × a power of two (DSD64 → 352.8k, 176.4k, 88.2k, 44.1k).
+    // Channels are converted in parallel.  50 % modulation
+    // (dsd::kReferenceLevel in lib/DSDCodec.h, the SACD reference) is PCM
+    // full scale; louder DSD clips when bitType is an integer depth.
+    void toPCM(SampleRate sampleRate, BitType bitType = BitType::F32);
+    // Modulate loaded PCM to DSD at sampleRate, a multiple of 8 × the PCM
+    // rate; any other rate throws and leaves the audio as it was.  Integer
+    // PCM goes through F32 first; channels are modulated in parallel.  PCM
+    // full scale becomes dsd::kReferenceLevel (50 %) modulation, so toPCM()
+    // at the original rate restores the level.
+    void toDSD(SampleRate sampleRate);
 };
 
 } // namespace sk
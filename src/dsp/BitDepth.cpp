@@ -0,0 +1,96 @@
+#include "BitDepth.h"
+
+#include "../lib/Simd.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+using sk::BitType;
+using sk::dsp::Format;
+
+// ─── Dispatch ─────────────────────────────────────────────────────────────
+// Every level tabulates its kernels over these depths; converter() picks
+// the table of this CPU's level.
+constexpr std::array kDepths{BitType::I8,  BitType::I16, BitType::I24,
+                             BitType::I32, BitType::F32, BitType::F64};
+constexpr std::size_t kCount = kDepths.size();
+
+// ─── Kernels, once per ISA level ──────────────────────────────────────────
+namespace base {
+#define SK_KERNEL_LEVEL SK_BUILD_LEVEL
+#include "BitDepthKernels.inc"
+} // namespace base
+
+#if SINEKIT_SIMD_DISPATCH
+// SSSE3 adds nothing the SSE2 kernels use.
+namespace ssse3 = base;
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define SK_KERNEL_LEVEL SK_LEVEL_AVX2
+#include "BitDepthKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+#endif
+
+constexpr std::size_t indexOf(BitType bitType) {
+    std::size_t k = 0;
+    while (k < kCount && kDepths[k] != bitType)
+        ++k;
+    return k;
+}
+
+template <typename T> bool holds(BitType bitType) {
+    return sk::withSampleType(bitType, []<typename U>(std::type_identity<U>) {
+        return std::is_same_v<T, U>;
+    });
+}
+
+} // namespace
+
+sk::dsp::Converter sk::dsp::converter(BitType from, BitType to) {
+    const std::size_t f = indexOf(from);
+    const std::size_t t = indexOf(to);
+    if (f == kCount || t == kCount)
+        throw std::runtime_error("unsupported bit depth conversion");
+    return SK_SIMD_CALL(kernel, f * kCount + t);
+}
+
+template <typename From, typename To>
+std::size_t sk::dsp::convertSamples(const From *src, To *dst, std::size_t n,
+                                    BitType from, BitType to) {
+    if (!holds<From>(from) || !holds<To>(to))
+        throw std::runtime_error("sample type does not match bit depth");
+    return converter(from, to)(src, dst, n);
+}
+
+#define SK_CONVERT_FROM(From)                                                \
+    template std::size_t sk::dsp::convertSamples(                            \
+        const From *, std::uint8_t *, std::size_t, BitType, BitType);        \
+    template std::size_t sk::dsp::convertSamples(                            \
+        const From *, std::int16_t *, std::size_t, BitType, BitType);        \
+    template std::size_t sk::dsp::convertSamples(                            \
+        const From *, std::int32_t *, std::size_t, BitType, BitType);        \
+    template std::size_t sk::dsp::convertSamples(const From *, float *,      \
+                                                 std::size_t, BitType,       \
+                                                 BitType);                   \
+    template std::size_t sk::dsp::convertSamples(const From *, double *,     \
+                                                 std::size_t, BitType,       \
+                                                 BitType);
+
+SK_CONVERT_FROM(std::uint8_t)
+SK_CONVERT_FROM(std::int16_t)
+SK_CONVERT_FROM(std::int32_t)
+SK_CONVERT_FROM(float)
+SK_CONVERT_FROM(double)
+
+#undef SK_CONVERT_FROM
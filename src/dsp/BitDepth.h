@@ -0,0 +1,92 @@
+#pragma once
+#ifndef SINEKIT_BITDEPTH_H
+#define SINEKIT_BITDEPTH_H
+
+#include "../AudioTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace sk::dsp {
+
+// ── Sample formats ───────────────────────────────────────────────────────
+// What the conversions need to know of each in‑memory depth.  Integer
+// words scale symmetrically: full scale is 2^(Bits−1) − 1 either side of
+// Zero, the code for silence (nonzero only for unsigned, offset‑binary
+// words).  Float samples span [-1, 1].
+template <typename T, int B> struct IntegerFormat {
+    using Sample = T;
+    static constexpr int Bits = B;
+    static constexpr bool IsFloat = false;
+    static constexpr bool IsSigned = std::is_signed_v<T>;
+    static constexpr std::int32_t Zero =
+        IsSigned ? 0 : std::int32_t{1} << (B - 1);
+    static constexpr long double FullScale =
+        static_cast<long double>((std::int64_t{1} << (B - 1)) - 1);
+};
+
+template <typename T> struct FloatFormat {
+    using Sample = T;
+    static constexpr int Bits = 8 * sizeof(T);
+    static constexpr bool IsFloat = true;
+    static constexpr bool IsSigned = true;
+    static constexpr std::int32_t Zero = 0;
+    static constexpr long double FullScale = 1.0L;
+};
+
+template <BitType B> struct Format;
+template <> struct Format<BitType::I8> : IntegerFormat<std::uint8_t, 8> {};
+template <> struct Format<BitType::I16> : IntegerFormat<std::int16_t, 16> {};
+template <> struct Format<BitType::I24> : IntegerFormat<std::int32_t, 24> {};
+template <> struct Format<BitType::I32> : IntegerFormat<std::int32_t, 32> {};
+template <> struct Format<BitType::F32> : FloatFormat<float> {};
+template <> struct Format<BitType::F64> : FloatFormat<double> {};
+
+// Positive full‑scale value of an integer PCM word, as used by toBitDepth.
+[[nodiscard]] constexpr long double fullScale(BitType bitType) noexcept {
+    switch (bitType) {
+    case BitType::I8:
+        return Format<BitType::I8>::FullScale;
+    case BitType::I16:
+        return Format<BitType::I16>::FullScale;
+    case BitType::I24:
+        return Format<BitType::I24>::FullScale;
+    case BitType::I32:
+        return Format<BitType::I32>::FullScale;
+    default:
+        return 1.0L;
+    }
+}
+
+// ── Sample conversion between two in‑memory depths ───────────────────────
+// Converts a flat run of samples, so it serves whole channels and single
+// stream blocks alike.
+//   int   → int   : arithmetic shift by the difference in bit depth
+//   int   → float : divide by the source full‑scale value
+//   float → int   : clamp to [-1, 1], scale by the target full scale and
+//                   round to nearest (ties to even)
+//   float → float : plain cast
+// Offset‑binary words are re‑centred on the way through.  A kernel returns
+// how many samples lay outside [-1, 1] and were clipped; only float → int
+// conversions clip.
+//
+// One kernel is generated from the Format traits for every pair of I8,
+// I16, I24, I32, F32 and F64, so each inner loop is branch free with its
+// shifts and scales fixed at compile time; the I16, I24, F32 and F64 pairs
+// also have AVX2 kernels (float → int SSE2 ones too).  converter() picks
+// the kernel from the constexpr table of this CPU's ISA level, once per
+// call site, and throws for a depth without one.  src and dst must not
+// overlap.
+using Converter = std::size_t (*)(const void *src, void *dst, std::size_t n);
+
+[[nodiscard]] Converter converter(BitType from, BitType to);
+
+// Typed shorthand for converter(from, to)(src, dst, n); throws when From
+// or To is not the sample type of its depth.
+template <typename From, typename To>
+std::size_t convertSamples(const From *src, To *dst, std::size_t n,
+                           BitType from, BitType to);
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_BITDEPTH_H
@@ -0,0 +1,159 @@
+#include "DSDDecimator.h"
+
+#include "../lib/DSDCodec.h"
+#include "../lib/VectorMath.h"
+#include "FilterDesign.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+constexpr double kAttenuation = 120.0; // dB
+constexpr double kPassband = 0.45;     // × the output rate
+// DSD idle pattern: four ones and four zeros, i.e. zero in PCM terms.
+constexpr std::uint8_t kSilence = 0x69;
+constexpr std::size_t kRunBytes = std::size_t{1} << 16;
+
+} // namespace
+
+sk::dsp::DSDDecimator::DSDDecimator(std::uint32_t dsdRate,
+                                    std::uint32_t pcmRate) {
+    if (pcmRate == 0 || dsdRate % pcmRate != 0)
+        throw std::runtime_error("DSD rate is not a multiple of PCM rate");
+    Ratio_ = dsdRate / pcmRate;
+    if (Ratio_ < 8 || !std::has_single_bit(Ratio_))
+        throw std::runtime_error("unsupported DSD decimation ratio");
+
+    // Each stage only has to keep its aliases out of the final passband,
+    // so everything up to (its output rate − passband) may fold into the
+    // band the later stages remove.
+    const double pass = kPassband * pcmRate;
+    double rate = dsdRate;
+    double out = dsdRate / 8.0;
+    const std::size_t first =
+        (kaiserLength(kAttenuation, (out - 2 * pass) / rate) + 7) / 8 * 8;
+    std::vector<double> h =
+        kaiserLowpass(first, (out / 2) / rate, kAttenuation);
+    for (double &tap : h)
+        tap /= sk::dsd::kReferenceLevel;
+
+    Tables_.resize(first / 8);
+    for (std::size_t k = 0; k < Tables_.size(); ++k) {
+        for (unsigned v = 0; v < 256; ++v) {
+            double sum = 0;
+            for (unsigned b = 0; b < 8; ++b)
+                sum += ((v >> (7 - b)) & 1u) ? h[8 * k + b] : -h[8 * k + b];
+            Tables_[k][v] = static_cast<float>(sum);
+        }
+    }
+    // A stage‑one output centres on the middle of its window, which ends
+    // on the last bit of the newest byte.
+    double delay = (static_cast<double>(first) - 1) / 2 - 7;
+
+    double unit = 8; // DSD samples per input sample of the next stage
+    while (out > pcmRate) {
+        rate = out;
+        out /= 2;
+        Stage stage;
+        stage.Length = kaiserLength(kAttenuation, (out - 2 * pass) / rate);
+        if (out == pcmRate) {
+            // Each extra tap in the last stage adds a quarter of an output
+            // sample of delay; use that to make the total come out close
+            // to a whole number of output samples.
+            auto miss = [&](std::size_t length) {
+                const double d =
+                    (delay + (static_cast<double>(length) - 1) / 2 * unit) /
+                    Ratio_;
+                return std::abs(d - std::round(d));
+            };
+            const std::size_t shortest = stage.Length;
+            for (std::size_t length = shortest + 1; length < shortest + 4;
+                 ++length)
+                if (miss(length) < miss(stage.Length))
+                    stage.Length = length;
+        }
+        const std::vector<double> taps =
+            kaiserLowpass(stage.Length, (out / 2) / rate, kAttenuation);
+        stage.Taps.assign((stage.Length + 7) / 8 * 8, 0.0f);
+        std::copy(taps.begin(), taps.end(), stage.Taps.begin());
+        delay += (static_cast<double>(stage.Length) - 1) / 2 * unit;
+        unit *= 2;
+        Stages_.push_back(std::move(stage));
+    }
+    Latency_ = static_cast<std::size_t>(std::lround(delay / Ratio_));
+    reset();
+}
+
+void sk::dsp::DSDDecimator::reset() {
+    Bytes_.assign(Tables_.size() - 1, kSilence);
+    for (Stage &stage : Stages_)
+        stage.History.assign(stage.Length - 1, 0.0f);
+}
+
+std::size_t sk::dsp::DSDDecimator::process(const std::uint8_t *in,
+                                           std::size_t bytes, float *out) {
+    // Stage one: one output per byte, summed from the slice tables.
+    const std::size_t slices = Tables_.size();
+    Bytes_.insert(Bytes_.end(), in, in + bytes);
+    float *first = Stages_.empty() ? out : (Scratch_.resize(bytes),
+                                            Scratch_.data());
+    for (std::size_t n = 0; n < bytes; ++n) {
+        const std::uint8_t *window = Bytes_.data() + n;
+        float acc = 0;
+        for (std::size_t k = 0; k < slices; ++k)
+            acc += Tables_[k][window[k]];
+        first[n] = acc;
+    }
+    Bytes_.erase(Bytes_.begin(), Bytes_.begin() + bytes);
+
+    // Halving stages; each output window starts two samples after the
+    // previous one.
+    std::size_t count = bytes;
+    for (std::size_t s = 0; s < Stages_.size(); ++s) {
+        Stage &stage = Stages_[s];
+        const float *src = Scratch_.data();
+        stage.History.insert(stage.History.end(), src, src + count);
+        const std::size_t taps = stage.Taps.size();
+        const std::size_t n = stage.History.size() < taps
+                                  ? 0
+                                  : (stage.History.size() - taps) / 2 + 1;
+        float *dst = s + 1 == Stages_.size() ? out : Scratch_.data();
+        for (std::size_t i = 0; i < n; ++i)
+            dst[i] = sk::vec::dot(stage.Taps.data(),
+                                  stage.History.data() + 2 * i, taps);
+        stage.History.erase(stage.History.begin(),
+                            stage.History.begin() + 2 * n);
+        count = n;
+    }
+    return count;
+}
+
+void sk::dsp::DSDDecimator::run(const std::uint8_t *in,
+                                std::uint64_t samples, float *out) {
+    reset();
+    const std::uint64_t frames = samples / Ratio_;
+    const std::uint64_t bytes = (samples + 7) / 8;
+    std::size_t skip = Latency_;
+    std::uint64_t written = 0;
+    std::vector<float> block(maxOutput(kRunBytes));
+
+    auto take = [&](std::size_t n) {
+        const std::size_t drop = std::min(skip, n);
+        skip -= drop;
+        const auto keep = static_cast<std::size_t>(
+            std::min<std::uint64_t>(n - drop, frames - written));
+        std::copy_n(block.data() + drop, keep, out + written);
+        written += keep;
+    };
+    for (std::uint64_t pos = 0; pos < bytes; pos += kRunBytes) {
+        const auto n = static_cast<std::size_t>(
+            std::min<std::uint64_t>(kRunBytes, bytes - pos));
+        take(process(in + pos, n, block.data()));
+    }
+    // Flush the filters with silence until the delayed tail is out.
+    const std::vector<std::uint8_t> silence(kRunBytes, kSilence);
+    while (written < frames)
+        take(process(silence.data(), silence.size(), block.data()));
+}
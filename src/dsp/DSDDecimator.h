@@ -0,0 +1,70 @@
+#pragma once
+#ifndef SINEKIT_DSDDECIMATOR_H
+#define SINEKIT_DSDDECIMATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sk::dsp {
+
+// ── Multistage DSD → PCM decimator for one channel ───────────────────────
+// Stage one filters the 1‑bit stream and decimates by 8 in a single step:
+// its FIR is split into 8‑tap slices, and for every slice a 256‑entry table
+// holds the slice's response to each possible byte, so one output costs
+// one table read per slice instead of eight multiply‑adds.  The remaining
+// factor of two stages are float FIR halving filters with SIMD dot
+// products.  Every stage is a Kaiser windowed sinc sized for 120 dB of
+// alias rejection over 0.45 × the output rate.
+//
+// DSD bytes are in SineKit's order (oldest sample in the MSB).  A set bit
+// maps to +1 / dsd::kReferenceLevel, a clear one to the negative of that,
+// and the filters have unity DC gain; so 50 % modulation decodes to PCM
+// full scale, matching DSDModulator.
+class DSDDecimator {
+  public:
+    // pcmRate must divide dsdRate by 8 × a power of two.
+    DSDDecimator(std::uint32_t dsdRate, std::uint32_t pcmRate);
+
+    [[nodiscard]] std::uint32_t ratio() const noexcept { return Ratio_; }
+    // Group delay of the whole chain, in output samples.
+    [[nodiscard]] std::size_t latency() const noexcept { return Latency_; }
+    // Upper bound on what process() produces from `bytes` input bytes.
+    [[nodiscard]] std::size_t maxOutput(std::size_t bytes) const noexcept {
+        return bytes * 8 / Ratio_ + 1;
+    }
+
+    // Return to the state of a freshly built decimator (filters primed
+    // with DSD silence).
+    void reset();
+
+    // Stream `bytes` DSD bytes through the chain and append the outputs
+    // that became available to out; returns how many were written.  The
+    // outputs lag the input by latency().
+    std::size_t process(const std::uint8_t *in, std::size_t bytes,
+                        float *out);
+
+    // Whole‑stream convenience: decode `samples` DSD samples into exactly
+    // samples / ratio() outputs, with the latency removed.
+    void run(const std::uint8_t *in, std::uint64_t samples, float *out);
+
+  private:
+    struct Stage {
+        std::vector<float> Taps; // zero padded to a multiple of 8
+        std::vector<float> History;
+        std::size_t Length{0};
+    };
+
+    std::uint32_t Ratio_;
+    std::size_t Latency_{0};
+    // Stage one: one table per 8‑tap slice, and the last Slices_ − 1 bytes.
+    std::vector<std::array<float, 256>> Tables_;
+    std::vector<std::uint8_t> Bytes_;
+    std::vector<Stage> Stages_;
+    std::vector<float> Scratch_;
+};
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_DSDDECIMATOR_H
@@ -0,0 +1,294 @@
+#include "DSDModulator.h"
+
+#include "../lib/DSDCodec.h"
+#include "../lib/VectorMath.h"
+#include "FilterDesign.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+
+namespace {
+
+using Complex = std::complex<double>;
+
+constexpr double kAttenuation = 120.0; // dB, interpolation filters
+constexpr double kPassband = 0.45;     // × the PCM rate
+constexpr double kFrontRate = 705600;  // FIR interpolation up to here
+constexpr double kBandEdge = 20000;    // noise shaping band
+constexpr double kMaxGain = 1.45;      // out‑of‑band NTF gain
+// The quantiser error of a stable loop stays well inside ±2 and its
+// filter state within a few units.  Clamping the one and resetting the
+// other if it still grows keeps an overloaded loop from running away.
+constexpr double kErrorLimit = 2.0;
+constexpr double kStateLimit = 16.0;
+constexpr std::size_t kRunFrames = 4096;
+
+// Roots of the Legendre polynomial P_n, ascending; the optimal places for
+// n noise transfer zeros across a band normalised to [−1, 1].
+std::vector<double> legendreRoots(std::size_t n) {
+    std::vector<double> roots(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        double x = std::cos(std::numbers::pi *
+                            (static_cast<double>(i) + 0.75) /
+                            (static_cast<double>(n) + 0.5));
+        for (int iter = 0; iter < 100; ++iter) {
+            double p0 = 1;
+            double p1 = x;
+            for (std::size_t k = 2; k <= n; ++k) {
+                const double p2 =
+                    ((2.0 * k - 1) * x * p1 - (k - 1.0) * p0) / k;
+                p0 = p1;
+                p1 = p2;
+            }
+            const double dp = n * (x * p1 - p0) / (x * x - 1);
+            const double dx = p1 / dp;
+            x -= dx;
+            if (std::abs(dx) < 1e-15)
+                break;
+        }
+        roots[n - 1 - i] = x;
+    }
+    return roots;
+}
+
+// Real coefficients of Π (1 − r z⁻¹) over roots that come in conjugate
+// pairs.
+std::vector<double> expand(const std::vector<Complex> &roots) {
+    std::vector<Complex> p{1.0};
+    for (const Complex &r : roots) {
+        p.push_back(0.0);
+        for (std::size_t i = p.size() - 1; i > 0; --i)
+            p[i] -= r * p[i - 1];
+    }
+    std::vector<double> real(p.size());
+    for (std::size_t i = 0; i < p.size(); ++i)
+        real[i] = p[i].real();
+    return real;
+}
+
+Complex evaluate(const std::vector<double> &poly, Complex zInv) {
+    Complex sum = 0;
+    for (auto it = poly.rbegin(); it != poly.rend(); ++it)
+        sum = sum * zInv + *it;
+    return sum;
+}
+
+// Poles of an order‑n Butterworth high‑pass with prewarped cutoff
+// tan(ωc / 2) = omega, mapped to z by the bilinear transform.
+std::vector<Complex> butterworthHighpass(std::size_t n, double omega) {
+    std::vector<Complex> poles(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        const Complex s = std::polar(
+            1.0, std::numbers::pi * (2.0 * k + n + 1) / (2.0 * n));
+        const Complex p = omega / s;
+        poles[k] = (1.0 + p) / (1.0 - p);
+    }
+    return poles;
+}
+
+struct NTF {
+    std::vector<double> B;
+    std::vector<double> A;
+};
+
+NTF designNTF(std::size_t order, double bandEdge) {
+    NTF ntf;
+    std::vector<Complex> zeros;
+    for (double g : legendreRoots(order))
+        zeros.push_back(std::polar(1.0, g * bandEdge));
+    ntf.B = expand(zeros);
+
+    auto peak = [&] {
+        double gain = 0;
+        for (int i = 0; i <= 512; ++i) {
+            const double w =
+                bandEdge + (std::numbers::pi - bandEdge) * i / 512.0;
+            const Complex zInv = std::polar(1.0, -w);
+            gain = std::max(gain, std::abs(evaluate(ntf.B, zInv) /
+                                           evaluate(ntf.A, zInv)));
+        }
+        return gain;
+    };
+    // A higher cutoff pushes more noise out of band; bisect (in log
+    // frequency) for the highest one the gain limit allows.
+    double lo = std::log(1e-6);
+    double hi = std::log(1e2);
+    for (int iter = 0; iter < 80; ++iter) {
+        const double mid = (lo + hi) / 2;
+        ntf.A = expand(butterworthHighpass(order, std::exp(mid)));
+        (peak() > kMaxGain ? hi : lo) = mid;
+    }
+    ntf.A = expand(butterworthHighpass(order, std::exp(lo)));
+    return ntf;
+}
+
+} // namespace
+
+sk::dsp::DSDModulator::DSDModulator(std::uint32_t pcmRate,
+                                    std::uint32_t dsdRate) {
+    if (pcmRate == 0 || dsdRate % pcmRate != 0 ||
+        (dsdRate / pcmRate) % 8 != 0)
+        throw std::runtime_error("DSD rate is not a multiple of 8 × PCM rate");
+    Ratio_ = dsdRate / pcmRate;
+
+    const double pass = kPassband * pcmRate;
+    double rate = pcmRate;
+    double delay = 0; // DSD samples
+    while (rate < kFrontRate &&
+           (dsdRate / static_cast<std::uint32_t>(rate)) % 2 == 0) {
+        // Stage output at 2 × rate; the images of the passband start at
+        // rate − pass.
+        const double out = 2 * rate;
+        const std::size_t length =
+            kaiserLength(kAttenuation, (rate - 2 * pass) / out);
+        const std::vector<double> h =
+            kaiserLowpass(length, (rate / 2) / out, kAttenuation);
+        const std::size_t padded = ((length + 1) / 2 + 7) / 8 * 8;
+
+        Stage stage;
+        stage.Even.assign(padded, 0.0f);
+        stage.Odd.assign(padded, 0.0f);
+        // Zero stuffing halves the gain, hence the factor 2.
+        for (std::size_t j = 0; j < length; ++j) {
+            auto &branch = j % 2 == 0 ? stage.Even : stage.Odd;
+            branch[padded - 1 - j / 2] = static_cast<float>(2 * h[j]);
+        }
+        Stages_.push_back(std::move(stage));
+        delay += (static_cast<double>(length) - 1) / 2 * (dsdRate / out);
+        rate = out;
+    }
+
+    const auto factor = static_cast<std::size_t>(dsdRate / rate);
+    Weights_.resize(factor);
+    for (std::size_t k = 0; k < factor; ++k)
+        Weights_[k] = static_cast<double>(k) / static_cast<double>(factor);
+    delay += static_cast<double>(factor);
+    Latency_ = static_cast<std::size_t>(std::lround(delay));
+
+    const double bandEdge =
+        2 * std::numbers::pi * kBandEdge / static_cast<double>(dsdRate);
+    const NTF ntf = designNTF(kOrder, bandEdge);
+    for (std::size_t i = 0; i <= kOrder; ++i) {
+        C_[i] = ntf.B[i] - ntf.A[i];
+        A_[i] = ntf.A[i];
+    }
+    reset();
+}
+
+void sk::dsp::DSDModulator::reset() {
+    for (Stage &stage : Stages_)
+        stage.History.assign(stage.Even.size() - 1, 0.0f);
+    Previous_ = 0;
+    State_.fill(0);
+    Byte_ = 0;
+    Bits_ = 0;
+    Skip_ = 0;
+}
+
+std::size_t sk::dsp::DSDModulator::process(const float *in, std::size_t n,
+                                           std::uint8_t *out) {
+    // Interpolation: each input sample yields one output from each
+    // polyphase branch over the window that ends on it.
+    const float *src = in;
+    std::size_t count = n;
+    for (std::size_t s = 0; s < Stages_.size(); ++s) {
+        Stage &stage = Stages_[s];
+        stage.History.insert(stage.History.end(), src, src + count);
+        std::vector<float> &dst = Scratch_[s % 2];
+        dst.resize(2 * count);
+        const std::size_t taps = stage.Even.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            const float *window = stage.History.data() + i;
+            dst[2 * i] = sk::vec::dot(stage.Even.data(), window, taps);
+            dst[2 * i + 1] = sk::vec::dot(stage.Odd.data(), window, taps);
+        }
+        stage.History.erase(stage.History.begin(),
+                            stage.History.begin() + count);
+        src = dst.data();
+        count *= 2;
+    }
+
+    // Linear interpolation straight into the modulator; the loop state
+    // lives in locals for the duration of the block.
+    std::array<double, kOrder> state = State_;
+    const std::array<double, kOrder + 1> c = C_;
+    const std::array<double, kOrder + 1> a = A_;
+    std::uint32_t byte = Byte_;
+    unsigned bits = Bits_;
+    std::uint8_t *const begin = out;
+    const std::size_t factor = Weights_.size();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const double from = Previous_;
+        const double step = src[i] - Previous_;
+        Previous_ = src[i];
+        if (std::abs(state[0]) > kStateLimit)
+            state.fill(0);
+        std::size_t k = 0;
+        if (Skip_ > 0) {
+            k = static_cast<std::size_t>(
+                std::min<std::uint64_t>(Skip_, factor));
+            Skip_ -= k;
+        }
+        for (; k < factor; ++k) {
+            const double x =
+                sk::dsd::kReferenceLevel * (from + step * Weights_[k]);
+            const double u = x + state[0];
+            const bool one = u >= 0;
+            const double e =
+                std::clamp((one ? 1.0 : -1.0) - u, -kErrorLimit, kErrorLimit);
+            const double f = state[0];
+            for (std::size_t j = 0; j + 1 < kOrder; ++j)
+                state[j] = state[j + 1] + c[j + 1] * e - a[j + 1] * f;
+            state[kOrder - 1] = c[kOrder] * e - a[kOrder] * f;
+
+            byte = (byte << 1) | static_cast<std::uint32_t>(one);
+            if (++bits == 8) {
+                *out++ = static_cast<std::uint8_t>(byte);
+                byte = 0;
+                bits = 0;
+            }
+        }
+    }
+    State_ = state;
+    Byte_ = byte;
+    Bits_ = bits;
+    return static_cast<std::size_t>(out - begin);
+}
+
+template <typename T>
+void sk::dsp::DSDModulator::run(const T *in, std::uint64_t frames,
+                                std::uint8_t *out) {
+    reset();
+    Skip_ = Latency_;
+    const std::uint64_t total = frames * Ratio_ / 8;
+    std::uint64_t written = 0;
+    std::vector<float> block(kRunFrames);
+    std::vector<std::uint8_t> bytes(kRunFrames * Ratio_ / 8 + 1);
+
+    auto take = [&](std::size_t n) {
+        const auto keep = static_cast<std::size_t>(
+            std::min<std::uint64_t>(n, total - written));
+        std::copy_n(bytes.data(), keep, out + written);
+        written += keep;
+    };
+    for (std::uint64_t pos = 0; pos < frames; pos += kRunFrames) {
+        const auto n = static_cast<std::size_t>(
+            std::min<std::uint64_t>(kRunFrames, frames - pos));
+        for (std::size_t i = 0; i < n; ++i)
+            block[i] = static_cast<float>(in[pos + i]);
+        take(process(block.data(), n, bytes.data()));
+    }
+    // Flush the interpolators with silence until the delayed tail is out.
+    std::fill(block.begin(), block.end(), 0.0f);
+    while (written < total)
+        take(process(block.data(), block.size(), bytes.data()));
+}
+
+template void sk::dsp::DSDModulator::run<float>(const float *, std::uint64_t,
+                                                std::uint8_t *);
+template void sk::dsp::DSDModulator::run<double>(const double *,
+                                                 std::uint64_t,
+                                                 std::uint8_t *);
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef SINEKIT_DSDMODULATOR_H
+#define SINEKIT_DSDMODULATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sk::dsp {
+
+// ── PCM → DSD sigma‑delta modulator for one channel ──────────────────────
+// The PCM is first brought to at least 705.6 kHz by float FIR doubling
+// stages (polyphase, SIMD dot products), then linearly interpolated to the
+// DSD rate, whose images the noise shaping swamps anyway.  The modulator
+// is a 7th‑order error feedback loop around a 1‑bit quantiser.  Its noise
+// transfer function is designed when the modulator is built: zeros spread
+// over 0–20 kHz at the Gauss–Legendre points, poles from a Butterworth
+// high‑pass tuned until the out‑of‑band gain is 1.45, just inside Lee's
+// criterion.
+//
+// PCM full scale is modulated to dsd::kReferenceLevel (50 %, the SACD
+// reference), which keeps a loop of this order stable; a loop that
+// overloads regardless is reset.  Output bytes are in SineKit's DSD order,
+// oldest sample in the MSB.
+class DSDModulator {
+  public:
+    static constexpr std::size_t kOrder = 7;
+
+    // dsdRate must be a multiple of 8 × pcmRate.
+    DSDModulator(std::uint32_t pcmRate, std::uint32_t dsdRate);
+
+    [[nodiscard]] std::uint32_t ratio() const noexcept { return Ratio_; }
+    // Delay of the interpolation front end, in DSD samples.
+    [[nodiscard]] std::size_t latency() const noexcept { return Latency_; }
+
+    // Return to the state of a freshly built modulator.
+    void reset();
+
+    // Modulate n PCM samples and write the completed bytes to out (at most
+    // n × ratio() / 8 + 1 of them); returns how many were written.  The
+    // output lags the input by latency().
+    std::size_t process(const float *in, std::size_t n, std::uint8_t *out);
+
+    // Whole‑channel convenience: modulate `frames` samples into exactly
+    // frames × ratio() / 8 bytes, with the latency removed.  T is float or
+    // double.
+    template <typename T>
+    void run(const T *in, std::uint64_t frames, std::uint8_t *out);
+
+  private:
+    struct Stage {
+        // Both polyphase branches, reversed and zero padded at the front
+        // to a multiple of 8 so a window of the newest inputs lines up.
+        std::vector<float> Even;
+        std::vector<float> Odd;
+        std::vector<float> History;
+    };
+
+    std::uint32_t Ratio_;
+    std::size_t Latency_{0};
+    std::vector<Stage> Stages_;
+    // Linear interpolation from the last stage to the DSD rate.
+    std::vector<double> Weights_;
+    float Previous_{0};
+    // Error feedback filter F = NTF − 1 = (B − A) / A, transposed direct
+    // form II state.
+    std::array<double, kOrder + 1> C_{};
+    std::array<double, kOrder + 1> A_{};
+    std::array<double, kOrder> State_{};
+    std::uint32_t Byte_{0};
+    unsigned Bits_{0};
+    std::uint64_t Skip_{0};
+    std::vector<float> Scratch_[2];
+};
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_DSDMODULATOR_H
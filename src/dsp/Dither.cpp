@@ -0,0 +1,241 @@
+#include "Dither.h"
+
+#include "../lib/Simd.h"
+#include "BitDepth.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+using sk::BitType;
+using sk::NoiseShaping;
+using sk::dsp::Dither;
+
+constexpr std::size_t kLanes = Dither::kLanes;
+// Frames per block; a block's staged lanes stay in L1.
+constexpr std::size_t kBlock = 256;
+
+// Error feedback coefficients h₁ … h_N; the noise transfer function is
+// 1 − Σ h_k z⁻ᵏ.
+constexpr std::array<double, 1> kFirstOrder{1.0};
+constexpr std::array<double, 5> kEWeighted{2.033, -2.165, 1.959, -1.590,
+                                           0.6149};
+constexpr std::array<double, 9> kFWeighted{
+    2.412, -3.370, 3.937, -4.174, 3.353, -2.205, 1.281, -0.569, 0.0847};
+static_assert(kFWeighted.size() == Dither::kMaxTaps);
+
+// Wellons' lowbias32, a full‑avalanche bijection of 32‑bit words.  Only
+// 32‑bit multiplies, so they vectorise.
+constexpr std::uint32_t hash(std::uint32_t x) noexcept {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+// Triangular noise in (−width, width) LSB from one hash: the difference of
+// its two 16‑bit halves, unit = width / 2¹⁶.
+inline double tpdf(std::uint32_t h, double unit) {
+    const auto diff = static_cast<std::int32_t>(h & 0xFFFFU) -
+                      static_cast<std::int32_t>(h >> 16);
+    return unit * static_cast<double>(diff);
+}
+
+// One block of up to kLanes channels run in lockstep.  Lanes past Count
+// read zeros and write to scratch.
+template <typename To> struct Lanes {
+    // Samples already in units of the target LSB.
+    const double *In[kLanes];
+    To *Out[kLanes];
+    std::uint32_t Keys[kLanes];
+    double *History[kLanes];
+    std::size_t Count;
+};
+
+// ─── Kernels, once per ISA level ──────────────────────────────────────────
+namespace base {
+#define SK_KERNEL_LEVEL SK_BUILD_LEVEL
+#include "DitherKernels.inc"
+} // namespace base
+
+#if SINEKIT_SIMD_DISPATCH
+// Only AVX2 has hand‑written kernels here.
+namespace ssse3 = base;
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define SK_KERNEL_LEVEL SK_LEVEL_AVX2
+#include "DitherKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+#endif
+
+double widthOf(sk::DitherAmount amount) {
+    switch (amount) {
+    case sk::DitherAmount::Low:
+        return 0.5;
+    case sk::DitherAmount::Medium:
+        return 1.0;
+    case sk::DitherAmount::High:
+        return 1.5;
+    default:
+        return 0.0;
+    }
+}
+
+} // namespace
+
+sk::dsp::Dither::Dither(DitherAmount amount, NoiseShaping shaping,
+                        std::size_t channels, std::uint32_t seed)
+    : Width_(widthOf(amount)), Shaping_(shaping), Keys_(channels),
+      Error_(channels * kMaxTaps) {
+    for (std::size_t c = 0; c < channels; ++c)
+        Keys_[c] = hash((seed + static_cast<std::uint32_t>(c)) *
+                            0x9e3779b9U +
+                        0x85ebca6bU);
+}
+
+bool sk::dsp::Dither::applies(BitType from, BitType to) noexcept {
+    if (to == BitType::I16)
+        return from == BitType::I24 || from == BitType::I32 ||
+               from == BitType::F32 || from == BitType::F64;
+    if (to == BitType::I24)
+        return from == BitType::I32 || from == BitType::F32 ||
+               from == BitType::F64;
+    return false;
+}
+
+void sk::dsp::Dither::reset() {
+    Counter_ = 0;
+    std::fill(Error_.begin(), Error_.end(), 0.0);
+}
+
+template <typename From, typename To>
+std::size_t sk::dsp::Dither::process(const From *const *src, To *const *dst,
+                                     std::size_t n, BitType from,
+                                     BitType to) {
+    if (!applies(from, to))
+        throw std::runtime_error(
+            "dither needs a conversion to a narrower integer depth");
+    if constexpr (std::integral<To>) {
+        const double scale =
+            std::floating_point<From>
+                ? static_cast<double>(fullScale(to))
+                : std::ldexp(1.0, bitsPerSample(to) - bitsPerSample(from));
+        const auto high = static_cast<double>(fullScale(to));
+        const double low = -high - 1;
+
+        std::size_t clipped = 0;
+        // Splits [0, n) where the low counter word wraps, since the keys
+        // change there.
+        auto run = [&](std::size_t done, std::size_t limit) {
+            const std::uint64_t counter = Counter_ + done;
+            return static_cast<std::size_t>(std::min<std::uint64_t>(
+                {limit, n - done,
+                 (std::uint64_t{1} << 32) - static_cast<std::uint32_t>(
+                                                counter)}));
+        };
+        auto epoch = [&](std::size_t done) {
+            return hash(static_cast<std::uint32_t>((Counter_ + done) >> 32));
+        };
+
+        if (Shaping_ == NoiseShaping::None) {
+            for (std::size_t c = 0; c < Keys_.size(); ++c) {
+                for (std::size_t done = 0; done < n;) {
+                    const std::size_t m = run(done, n);
+                    clipped += SK_SIMD_CALL(
+                        ditherFlat, src[c] + done, dst[c] + done, m, scale,
+                        low, high, Keys_[c] ^ epoch(done),
+                        static_cast<std::uint32_t>(Counter_ + done), Width_);
+                    done += m;
+                }
+            }
+            Counter_ += n;
+            return clipped;
+        }
+
+        const double unit = Width_ / 65536.0;
+        std::array<std::array<double, kBlock>, kLanes> stage{};
+        std::array<To, kBlock> spareOut;
+        std::array<double, kMaxTaps> spareHistory{};
+
+        for (std::size_t g = 0; g < Keys_.size(); g += kLanes) {
+            Lanes<To> block;
+            block.Count = std::min(kLanes, Keys_.size() - g);
+            for (std::size_t l = 0; l < kLanes; ++l) {
+                block.In[l] = stage[l].data();
+                block.History[l] = l < block.Count
+                                       ? Error_.data() + (g + l) * kMaxTaps
+                                       : spareHistory.data();
+                block.Keys[l] = 0;
+            }
+
+            for (std::size_t done = 0; done < n;) {
+                const std::size_t m = run(done, kBlock);
+                for (std::size_t l = 0; l < kLanes; ++l) {
+                    if (l < block.Count) {
+                        block.Keys[l] = Keys_[g + l] ^ epoch(done);
+                        block.Out[l] = dst[g + l] + done;
+                        clipped += SK_SIMD_CALL(load, src[g + l] + done,
+                                                stage[l].data(), m, scale);
+                    } else {
+                        block.Out[l] = spareOut.data();
+                    }
+                }
+                const auto lo = static_cast<std::uint32_t>(Counter_ + done);
+                switch (Shaping_) {
+                case NoiseShaping::FirstOrder:
+                    SK_SIMD_CALL(shape<kFirstOrder>, block, m, lo, unit, low,
+                                 high);
+                    break;
+                case NoiseShaping::EWeighted:
+                    SK_SIMD_CALL(shape<kEWeighted>, block, m, lo, unit, low,
+                                 high);
+                    break;
+                default:
+                    SK_SIMD_CALL(shape<kFWeighted>, block, m, lo, unit, low,
+                                 high);
+                    break;
+                }
+                done += m;
+            }
+        }
+        Counter_ += n;
+        return clipped;
+    } else {
+        return 0;
+    }
+}
+
+#define SK_DITHER_FROM(From)                                                 \
+    template std::size_t sk::dsp::Dither::process(                           \
+        const From *const *, std::uint8_t *const *, std::size_t, BitType,    \
+        BitType);                                                            \
+    template std::size_t sk::dsp::Dither::process(                           \
+        const From *const *, std::int16_t *const *, std::size_t, BitType,    \
+        BitType);                                                            \
+    template std::size_t sk::dsp::Dither::process(                           \
+        const From *const *, std::int32_t *const *, std::size_t, BitType,    \
+        BitType);                                                            \
+    template std::size_t sk::dsp::Dither::process(                           \
+        const From *const *, float *const *, std::size_t, BitType, BitType); \
+    template std::size_t sk::dsp::Dither::process(                           \
+        const From *const *, double *const *, std::size_t, BitType,          \
+        BitType);
+
+SK_DITHER_FROM(std::uint8_t)
+SK_DITHER_FROM(std::int16_t)
+SK_DITHER_FROM(std::int32_t)
+SK_DITHER_FROM(float)
+SK_DITHER_FROM(double)
+
+#undef SK_DITHER_FROM
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef SINEKIT_DITHER_H
+#define SINEKIT_DITHER_H
+
+#include "../AudioTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sk::dsp {
+
+// ── Dithered requantisation to a narrower integer depth ──────────────────
+// The dither is TPDF, the difference of two 16‑bit uniforms taken from one
+// counter‑based hash of (channel key, frame index).  No generator state
+// links one sample to the next, so a block's noise is filled by a single
+// vector pass.  The quantisation error, dither included, is fed back
+// through the NoiseShaping filter H, which gives the total noise the
+// transfer function 1 − H(z).
+//
+// The feedback is serial within a channel, so channels run in lockstep,
+// kLanes to a vector: the loop then carries kLanes independent chains.
+// Their filter history stays in registers for a whole block and is only
+// written back between blocks, so consecutive process() calls join
+// seamlessly.
+//
+// Float input is clamped to [-1, 1] and scaled by the target full scale as
+// convertSamples does; integer input is scaled by the difference in depth.
+class Dither {
+  public:
+    static constexpr std::size_t kLanes = 4;
+    static constexpr std::size_t kMaxTaps = 9;
+
+    // Channel c is keyed by seed + c; ditherers covering different
+    // channels of one signal should not overlap, so no two channels share
+    // their dither.
+    Dither(DitherAmount amount, NoiseShaping shaping,
+           std::size_t channels = 1, std::uint32_t seed = 0);
+
+    // Whether from → to reduces to a narrower integer depth, the only
+    // conversions process() accepts: F32 / F64 / I32 → I16 / I24, and
+    // I24 → I16.
+    [[nodiscard]] static bool applies(BitType from, BitType to) noexcept;
+
+    [[nodiscard]] std::size_t numChannels() const noexcept {
+        return Keys_.size();
+    }
+
+    // Return to the state of a freshly built ditherer.
+    void reset();
+
+    // Requantise n frames, src[c] and dst[c] being channel c's runs.
+    // Returns how many samples lay outside [-1, 1] and were clipped, as
+    // convertSamples does.  Throws for a pair applies() rejects.
+    template <typename From, typename To>
+    std::size_t process(const From *const *src, To *const *dst,
+                        std::size_t n, BitType from, BitType to);
+
+  private:
+    double Width_;
+    NoiseShaping Shaping_;
+    std::vector<std::uint32_t> Keys_;
+    std::uint64_t Counter_{0};
+    // kMaxTaps per channel, most recent error first.
+    std::vector<double> Error_;
+};
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_DITHER_H
@@ -0,0 +1,71 @@
+#include "FFT.h"
+
+#include "../lib/Simd.h"
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace {
+
+// ─── Kernels, once per ISA level ──────────────────────────────────────────
+namespace base {
+#define SK_KERNEL_LEVEL SK_BUILD_LEVEL
+#include "FFTKernels.inc"
+} // namespace base
+
+#if SINEKIT_SIMD_DISPATCH
+// Only AVX2 has a hand‑written kernel here.
+namespace ssse3 = base;
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define SK_KERNEL_LEVEL SK_LEVEL_AVX2
+#include "FFTKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+#endif
+
+} // namespace
+
+sk::dsp::FFT::FFT(std::size_t size) : Size_(size) {
+    if (size == 0 || (size & (size - 1)) != 0)
+        throw std::runtime_error("FFT size must be a power of two");
+    std::size_t bits = 0;
+    while ((std::size_t{1} << bits) < size)
+        ++bits;
+    for (std::size_t i = 0; i < size; ++i) {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < bits; ++b)
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        if (i < r) {
+            Swaps_.push_back(i);
+            Swaps_.push_back(r);
+        }
+    }
+    Twiddles_.reserve(size);
+    for (std::size_t h = 1; h < size; h <<= 1)
+        for (std::size_t k = 0; k < h; ++k)
+            Twiddles_.push_back(std::polar(
+                1.0, -std::numbers::pi * static_cast<double>(k) /
+                         static_cast<double>(h)));
+}
+
+void sk::dsp::FFT::forward(std::complex<double> *data) const {
+    transform<false>(data);
+}
+
+void sk::dsp::FFT::inverse(std::complex<double> *data) const {
+    transform<true>(data);
+}
+
+template <bool Inverse>
+void sk::dsp::FFT::transform(std::complex<double> *data) const {
+    for (std::size_t i = 0; i < Swaps_.size(); i += 2)
+        std::swap(data[Swaps_[i]], data[Swaps_[i + 1]]);
+    // Plain real arithmetic: std::complex multiplication goes through the
+    // NaN‑checking library routine unless -ffast-math is on.
+    auto *x = reinterpret_cast<double *>(data);
+    const auto *tw = reinterpret_cast<const double *>(Twiddles_.data());
+    SK_SIMD_CALL(butterflies<Inverse>, x, tw, Size_);
+}
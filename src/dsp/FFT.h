@@ -0,0 +1,40 @@
+#pragma once
+#ifndef SINEKIT_FFT_H
+#define SINEKIT_FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace sk::dsp {
+
+// ── Radix‑2 complex FFT ──────────────────────────────────────────────────
+// In place, iterative decimation in time.  The bit reversal permutation
+// and every stage's twiddles are tabulated when the transform is built, so
+// a transform is a single pass over the tables; one FFT may be shared by
+// any number of threads.
+class FFT {
+  public:
+    // size must be a power of two.
+    explicit FFT(std::size_t size);
+
+    [[nodiscard]] std::size_t size() const noexcept { return Size_; }
+
+    // X[k] = Σ x[n] e^(−2πi nk / N).
+    void forward(std::complex<double> *data) const;
+    // The same with e^(+2πi nk / N), unscaled: inverse(forward(x)) = N x.
+    void inverse(std::complex<double> *data) const;
+
+  private:
+    template <bool Inverse> void transform(std::complex<double> *data) const;
+
+    std::size_t Size_;
+    // Pairs (i, reverse(i)) with i < reverse(i).
+    std::vector<std::size_t> Swaps_;
+    // The stage of half width h uses entries h − 1 … 2h − 2.
+    std::vector<std::complex<double>> Twiddles_;
+};
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_FFT_H
@@ -0,0 +1,181 @@
+#include "FilterCache.h"
+
+#include "../io/MappedFile.h"
+#include "../lib/ByteReader.h"
+#include "../lib/EndianHelpers.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[5] = "SKFC";
+constexpr std::uint32_t kVersion = 1;
+
+} // namespace
+
+sk::dsp::FilterCache &sk::dsp::FilterCache::instance() {
+    static FilterCache cache;
+    return cache;
+}
+
+std::shared_ptr<const sk::dsp::Resampler>
+sk::dsp::FilterCache::resampler(const FilterSpec &spec) {
+    // Checked before the spec becomes a key; see FilterSpec::valid().
+    if (!spec.valid())
+        throw std::runtime_error("invalid resampling filter spec");
+    std::unique_lock lock(Mutex_);
+    auto [it, inserted] = Entries_.try_emplace(spec);
+    if (!inserted) {
+        // Designed already, or being designed by another thread.
+        const Pending pending = it->second;
+        lock.unlock();
+        return pending.get()->Filter;
+    }
+    std::promise<std::shared_ptr<const Design>> promise;
+    it->second = promise.get_future().share();
+    lock.unlock();
+
+    // Designed outside the lock, so other specs are not held up.
+    try {
+        auto design = std::make_shared<Design>();
+        design->Prototype = designPrototype(spec);
+        design->Filter = std::make_shared<const Resampler>(
+            spec.Up, spec.Down, design->Prototype);
+        promise.set_value(design);
+        return design->Filter;
+    } catch (...) {
+        // Forget the spec, so a later call tries again.
+        lock.lock();
+        Entries_.erase(spec);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+std::size_t sk::dsp::FilterCache::size() const {
+    std::lock_guard lock(Mutex_);
+    return Entries_.size();
+}
+
+void sk::dsp::FilterCache::clear() {
+    std::lock_guard lock(Mutex_);
+    Entries_.clear();
+}
+
+void sk::dsp::FilterCache::save(const std::filesystem::path &path) const {
+    // Only finished designs; one still in progress is left out.
+    std::vector<std::pair<FilterSpec, std::shared_ptr<const Design>>> done;
+    {
+        std::lock_guard lock(Mutex_);
+        for (const auto &[spec, pending] : Entries_)
+            if (pending.wait_for(std::chrono::seconds(0)) ==
+                std::future_status::ready)
+                done.emplace_back(spec, pending.get());
+    }
+
+    // Written aside and renamed into place, so a worker loading the file
+    // meanwhile never sees half of it.  The temporary name is unique to
+    // this process (a random token) and call, so concurrent savers never
+    // share one.
+    static const std::uint64_t token =
+        (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}();
+    static std::atomic<std::uint64_t> saves{0};
+    std::filesystem::path partial = path;
+    partial += ".partial." + std::to_string(token) + "." +
+               std::to_string(saves++);
+    try {
+        std::ofstream file(partial, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("create " + partial.string());
+        file.write(kMagic, 4);
+        sk::endian::write_le<std::uint32_t>(file, kVersion);
+        sk::endian::write_le<std::uint32_t>(
+            file, static_cast<std::uint32_t>(done.size()));
+        for (const auto &[spec, design] : done) {
+            sk::endian::write_le<std::uint32_t>(file, spec.Up);
+            sk::endian::write_le<std::uint32_t>(file, spec.Down);
+            sk::endian::write_le<std::uint32_t>(file, spec.Taps);
+            sk::endian::write_le<std::uint32_t>(
+                file, static_cast<std::uint32_t>(spec.Window));
+            sk::endian::write_le<double>(file, spec.Beta);
+            sk::endian::write_le<double>(file, spec.Spacing);
+            for (const double v : design->Prototype)
+                sk::endian::write_le<double>(file, v);
+        }
+        file.close();
+        if (!file)
+            throw std::runtime_error("filter cache write failed " +
+                                     partial.string());
+        std::filesystem::rename(partial, path);
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(partial, ignored);
+        throw;
+    }
+}
+
+std::size_t sk::dsp::FilterCache::load(const std::filesystem::path &path) {
+    const sk::io::MappedFile file(path);
+    sk::bytes::ByteReader in(file.data(), file.size());
+    if (!in.peekTag(kMagic))
+        throw std::runtime_error("not a filter cache " + path.string());
+    in.skip(4);
+    if (in.readLE<std::uint32_t>() != kVersion)
+        throw std::runtime_error("unsupported filter cache version " +
+                                 path.string());
+    const auto count = in.readLE<std::uint32_t>();
+
+    // Every entry is read and checked before any is added, so a damaged
+    // file adds nothing.
+    std::vector<std::pair<FilterSpec, std::shared_ptr<Design>>> entries;
+    for (std::uint32_t e = 0; e < count; ++e) {
+        FilterSpec spec;
+        spec.Up = in.readLE<std::uint32_t>();
+        spec.Down = in.readLE<std::uint32_t>();
+        spec.Taps = in.readLE<std::uint32_t>();
+        spec.Window = static_cast<WindowType>(in.readLE<std::uint32_t>());
+        spec.Beta = in.readLE<double>();
+        spec.Spacing = in.readLE<double>();
+        if (!spec.valid())
+            throw std::runtime_error("invalid filter spec in " +
+                                     path.string());
+        if (spec.Taps > in.remaining() / sizeof(double))
+            throw std::runtime_error("truncated filter cache " +
+                                     path.string());
+        auto design = std::make_shared<Design>();
+        design->Prototype.resize(spec.Taps);
+        for (double &v : design->Prototype) {
+            v = in.readLE<double>();
+            if (!std::isfinite(v))
+                throw std::runtime_error("invalid filter tap in " +
+                                         path.string());
+        }
+        entries.emplace_back(spec, std::move(design));
+    }
+
+    std::size_t added = 0;
+    for (auto &[spec, design] : entries) {
+        {
+            std::lock_guard lock(Mutex_);
+            if (Entries_.contains(spec))
+                continue;
+        }
+        // Splitting into phases is left outside the lock as in resampler().
+        design->Filter = std::make_shared<const Resampler>(
+            spec.Up, spec.Down, design->Prototype);
+        std::promise<std::shared_ptr<const Design>> promise;
+        promise.set_value(std::move(design));
+        std::lock_guard lock(Mutex_);
+        added += Entries_.try_emplace(spec, promise.get_future().share())
+                     .second;
+    }
+    return added;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef SINEKIT_FILTERCACHE_H
+#define SINEKIT_FILTERCACHE_H
+
+#include "Resampler.h"
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace sk::dsp {
+
+// ── Process‑wide cache of designed resamplers ────────────────────────────
+// Designing a prototype evaluates a sine and a Bessel function per tap,
+// and splitting it into phases (and FFT spectra) costs more again; batch
+// jobs resample thousands of files with the same few specs.  The first
+// caller of a spec designs it while others asking for the same spec wait
+// for that result and callers of other specs carry on; everybody then
+// shares one immutable Resampler.
+//
+// save() writes every prototype designed so far, and load() adds those of
+// a saved file without designing them, so new workers start hot.  The
+// file is little endian: "SKFC", a u32 version and entry count, then per
+// entry the spec (u32 Up, Down, Taps, Window; f64 Beta, Spacing) and its
+// Taps coefficients as f64.
+class FilterCache {
+  public:
+    static FilterCache &instance();
+
+    [[nodiscard]] std::shared_ptr<const Resampler>
+    resampler(const FilterSpec &spec);
+
+    [[nodiscard]] std::size_t size() const;
+    void clear();
+
+    void save(const std::filesystem::path &path) const;
+    // Returns how many entries were new; specs already present keep their
+    // design.  Throws, adding nothing, for a file that is not a saved
+    // cache or holds an entry that fails FilterSpec::valid().
+    std::size_t load(const std::filesystem::path &path);
+
+  private:
+    struct Design {
+        // Kept for save().
+        std::vector<double> Prototype;
+        std::shared_ptr<const Resampler> Filter;
+    };
+    using Pending = std::shared_future<std::shared_ptr<const Design>>;
+
+    mutable std::mutex Mutex_;
+    std::map<FilterSpec, Pending> Entries_;
+};
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_FILTERCACHE_H
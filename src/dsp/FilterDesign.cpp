@@ -0,0 +1,46 @@
+#include "FilterDesign.h"
+
+#include <algorithm>
+#include <boost/math/special_functions/bessel.hpp>
+#include <cmath>
+#include <numbers>
+
+std::size_t sk::dsp::kaiserLength(double attenuation, double width) {
+    const double n =
+        (attenuation - 7.95) / (2.285 * 2 * std::numbers::pi * width);
+    return static_cast<std::size_t>(std::ceil(std::max(n, 0.0))) + 1;
+}
+
+double sk::dsp::kaiserBeta(double attenuation) {
+    if (attenuation > 50)
+        return 0.1102 * (attenuation - 8.7);
+    if (attenuation >= 21)
+        return 0.5842 * std::pow(attenuation - 21, 0.4) +
+               0.07886 * (attenuation - 21);
+    return 0;
+}
+
+std::vector<double> sk::dsp::kaiserLowpass(std::size_t length, double cutoff,
+                                           double attenuation) {
+    const double beta = kaiserBeta(attenuation);
+    const double denom = boost::math::cyl_bessel_i(0.0, beta);
+    const double mid = (static_cast<double>(length) - 1) / 2;
+    std::vector<double> h(length);
+    double sum = 0;
+    for (std::size_t n = 0; n < length; ++n) {
+        const double t = static_cast<double>(n) - mid;
+        const double x = 2 * cutoff * t;
+        const double sinc =
+            t == 0 ? 1.0
+                   : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+        const double r = mid == 0 ? 0 : t / mid;
+        const double window =
+            boost::math::cyl_bessel_i(0.0, beta * std::sqrt(1 - r * r)) /
+            denom;
+        h[n] = 2 * cutoff * sinc * window;
+        sum += h[n];
+    }
+    for (double &v : h)
+        v /= sum;
+    return h;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#ifndef SINEKIT_FILTERDESIGN_H
+#define SINEKIT_FILTERDESIGN_H
+
+#include <cstddef>
+#include <vector>
+
+namespace sk::dsp {
+
+// Kaiser's estimate of the FIR length that reaches `attenuation` dB across
+// a transition band `width` wide (as a fraction of the sample rate).
+[[nodiscard]] std::size_t kaiserLength(double attenuation, double width);
+
+// Kaiser window β for a stopband of `attenuation` dB.
+[[nodiscard]] double kaiserBeta(double attenuation);
+
+// Linear phase Kaiser‑windowed sinc lowpass with its cutoff at `cutoff`
+// (fraction of the sample rate) and unity DC gain.
+[[nodiscard]] std::vector<double>
+kaiserLowpass(std::size_t length, double cutoff, double attenuation);
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_FILTERDESIGN_H
@@ -0,0 +1,96 @@
+#include "OverlapSave.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// One size‑N transform costs about kTransform × N log2 N and one spectrum
+// product about kProduct × N of the direct form's multiply‑adds, as
+// measured against sk::vec::dot with the block copies included.
+constexpr double kTransform = 8;
+constexpr double kProduct = 10;
+// Largest transform considered, 2^20 points.
+constexpr std::size_t kMaxSize = std::size_t{1} << 20;
+
+double costAt(std::size_t filters, std::size_t taps, std::size_t size) {
+    const double n = static_cast<double>(size);
+    const double f = static_cast<double>(filters);
+    const double transform = kTransform * n * std::log2(n);
+    const double perCall = (1 + f) * transform + f * kProduct * n;
+    return perCall / (2 * (n - static_cast<double>(taps) + 1) * f);
+}
+
+// The cheapest transform at least twice the filter length.
+std::size_t bestSize(std::size_t filters, std::size_t taps) {
+    std::size_t best = 0;
+    for (std::size_t size = 16; size <= kMaxSize; size <<= 1)
+        if (size >= 2 * taps &&
+            (best == 0 ||
+             costAt(filters, taps, size) < costAt(filters, taps, best)))
+            best = size;
+    return best;
+}
+
+} // namespace
+
+double sk::dsp::OverlapSave::cost(std::size_t filters, std::size_t taps) {
+    const std::size_t size = bestSize(filters, taps);
+    if (filters == 0 || size == 0)
+        return std::numeric_limits<double>::infinity();
+    return costAt(filters, taps, size);
+}
+
+sk::dsp::OverlapSave::OverlapSave(const std::vector<double> &filters,
+                                  std::size_t taps)
+    : Filters_(taps == 0 ? 0 : filters.size() / taps), Taps_(taps),
+      Fft_(std::max<std::size_t>(bestSize(Filters_, taps), 1)) {
+    if (Filters_ == 0 || Filters_ * taps != filters.size())
+        throw std::runtime_error("overlap-save filters of unequal length");
+    if (Fft_.size() < 2 * taps)
+        throw std::runtime_error("filter too long for overlap-save");
+    const std::size_t size = Fft_.size();
+    Valid_ = size - taps + 1;
+    Cost_ = costAt(Filters_, taps, size);
+    // Correlation with h is convolution with h reversed; the 1 / size of
+    // the inverse transform is folded in here.
+    Spectra_.assign(Filters_ * size, 0.0);
+    for (std::size_t f = 0; f < Filters_; ++f) {
+        std::complex<double> *spectrum = Spectra_.data() + f * size;
+        for (std::size_t j = 0; j < taps; ++j)
+            spectrum[j] = filters[f * taps + taps - 1 - j] /
+                          static_cast<double>(size);
+        Fft_.forward(spectrum);
+    }
+}
+
+void sk::dsp::OverlapSave::run(const double *in, double *out,
+                               std::complex<double> *work) const {
+    const std::size_t size = Fft_.size();
+    std::complex<double> *segments = work;
+    std::complex<double> *product = work + size;
+    // The second segment starts where the first one's valid outputs end.
+    for (std::size_t i = 0; i < size; ++i)
+        segments[i] = {in[i], in[Valid_ + i]};
+    Fft_.forward(segments);
+
+    const auto *z = reinterpret_cast<const double *>(segments);
+    auto *y = reinterpret_cast<double *>(product);
+    for (std::size_t f = 0; f < Filters_; ++f) {
+        const auto *h =
+            reinterpret_cast<const double *>(Spectra_.data() + f * size);
+        for (std::size_t k = 0; k < size; ++k) {
+            y[2 * k] = z[2 * k] * h[2 * k] - z[2 * k + 1] * h[2 * k + 1];
+            y[2 * k + 1] = z[2 * k] * h[2 * k + 1] + z[2 * k + 1] * h[2 * k];
+        }
+        Fft_.inverse(product);
+        double *first = out + f * step();
+        double *second = first + Valid_;
+        for (std::size_t t = 0; t < Valid_; ++t) {
+            first[t] = product[Taps_ - 1 + t].real();
+            second[t] = product[Taps_ - 1 + t].imag();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#ifndef SINEKIT_OVERLAPSAVE_H
+#define SINEKIT_OVERLAPSAVE_H
+
+#include "FFT.h"
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace sk::dsp {
+
+// ── FFT overlap‑save FIR bank ────────────────────────────────────────────
+// Runs a bank of equal‑length real FIR filters over one input.  A call
+// transforms two consecutive input segments at once, one as the real and
+// one as the imaginary part, and then spends one spectrum product and one
+// inverse transform per filter; as the filters are real, the two results
+// come back apart in the real and imaginary parts.  The first taps − 1
+// points of each segment are wrapped around and discarded, the rest are
+// exact.  The transform length is chosen to minimise the estimated work
+// per output, which then grows only with the log of the filter length.
+class OverlapSave {
+  public:
+    // filters holds count runs of taps coefficients each.
+    OverlapSave(const std::vector<double> &filters, std::size_t taps);
+
+    [[nodiscard]] std::size_t filters() const noexcept { return Filters_; }
+    // Positions each run() call produces for every filter.
+    [[nodiscard]] std::size_t step() const noexcept { return 2 * Valid_; }
+    // Input a run() call reads.
+    [[nodiscard]] std::size_t span() const noexcept {
+        return step() + Taps_ - 1;
+    }
+    // Complex values of scratch a run() call needs.
+    [[nodiscard]] std::size_t workspace() const noexcept {
+        return 2 * Fft_.size();
+    }
+    // Estimated work per position and filter, in the direct form's
+    // multiply‑adds, for the bank as built and for any bank of that shape;
+    // the direct form spends taps.
+    [[nodiscard]] double cost() const noexcept { return Cost_; }
+    [[nodiscard]] static double cost(std::size_t filters, std::size_t taps);
+
+    // out[f × step() + t] = Σ_j h_f[j] in[t + j] for t < step(), reading
+    // in[0, span()).  work holds workspace() values.
+    void run(const double *in, double *out,
+             std::complex<double> *work) const;
+
+  private:
+    std::size_t Filters_;
+    std::size_t Taps_;
+    std::size_t Valid_;
+    double Cost_;
+    FFT Fft_;
+    // Each filter's spectrum, reversed and scaled by 1 / size.
+    std::vector<std::complex<double>> Spectra_;
+};
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_OVERLAPSAVE_H
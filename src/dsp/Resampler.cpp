@@ -0,0 +1,157 @@
+#include "Resampler.h"
+
+#include "../lib/VectorMath.h"
+#include "FilterDesign.h"
+#include <algorithm>
+#include <boost/math/special_functions/bessel.hpp>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+sk::dsp::Resampler::Resampler(std::size_t up, std::size_t down,
+                              const std::vector<double> &prototype)
+    : Up_(up), Down_(down) {
+    if (up == 0 || down == 0)
+        throw std::runtime_error("resampling ratio must be positive");
+    if (prototype.size() % 2 == 0)
+        throw std::runtime_error("resampler needs an odd-length prototype");
+    // Output nL + p takes x[n + d] × h[c + dL − p] for every d that keeps
+    // the tap inside the prototype, so d runs over at most [−R, R].
+    const std::size_t c = prototype.size() / 2;
+    Step_ = std::gcd(up, down);
+    Reach_ = (c + up - 1) / up;
+    Taps_ = (2 * Reach_ + 1 + 3) / 4 * 4;
+    Phases_.assign(up / Step_ * Taps_, 0.0);
+    for (std::size_t p = 0; p < up; p += Step_) {
+        double *phase = Phases_.data() + p / Step_ * Taps_;
+        for (std::size_t j = 0; j < 2 * Reach_ + 1; ++j) {
+            const auto k = static_cast<std::ptrdiff_t>(c + j * up) -
+                           static_cast<std::ptrdiff_t>(Reach_ * up + p);
+            if (k >= 0 && k < static_cast<std::ptrdiff_t>(prototype.size()))
+                phase[j] = prototype[k];
+        }
+    }
+    // Both in multiply‑adds per output; the bank runs every phase at M / L
+    // positions per output.
+    const std::size_t phases = up / Step_;
+    const double fft = OverlapSave::cost(phases, Taps_) *
+                       static_cast<double>(phases * down) /
+                       static_cast<double>(up);
+    if (fft < static_cast<double>(Taps_))
+        Fast_.emplace(Phases_, Taps_);
+}
+
+void sk::dsp::Resampler::run(const double *in, std::size_t n,
+                             double *out) const {
+    // Reach_ zeros ahead of the input and enough behind it for the last
+    // window, rounded up taps included, or for the last FFT block.
+    const std::size_t step = Fast_ ? Fast_->step() : 0;
+    std::vector<double, sk::pool::Allocator<double>> padded(
+        n + Taps_ + Reach_ + step);
+    std::copy(in, in + n, padded.begin() + Reach_);
+    const std::uint64_t count = outputLength(n);
+    // Output k sits at stuffed position kM = nL + p; step n and p along.
+    std::size_t i = 0;
+    std::size_t p = 0;
+    auto advance = [&] {
+        p += Down_;
+        i += p / Up_;
+        p %= Up_;
+    };
+    if (!Fast_) {
+        for (std::uint64_t k = 0; k < count; ++k) {
+            out[k] = sk::vec::dot(Phases_.data() + p / Step_ * Taps_,
+                                  padded.data() + i, Taps_);
+            advance();
+        }
+        return;
+    }
+    // Every phase at step() positions a block, then pick the outputs.
+    std::vector<double, sk::pool::Allocator<double>> block(Fast_->filters() *
+                                                           step);
+    std::vector<std::complex<double>,
+                sk::pool::Allocator<std::complex<double>>>
+        work(Fast_->workspace());
+    std::uint64_t k = 0;
+    for (std::size_t b = 0; k < count; b += step) {
+        Fast_->run(padded.data() + b, block.data(), work.data());
+        for (; k < count && i < b + step; ++k) {
+            out[k] = block[p / Step_ * step + (i - b)];
+            advance();
+        }
+    }
+}
+
+bool sk::dsp::FilterSpec::valid() const noexcept {
+    // I0(β) overflows a double a little past β = 713.
+    constexpr double kMaxBeta = 700;
+    return Taps % 2 == 1 && Taps <= kMaxTaps && Up >= 1 && Up <= kMaxTaps &&
+           Down >= 1 && Down <= kMaxTaps && Window <= WindowType::KAISER &&
+           std::isfinite(Beta) && Beta >= 0 && Beta <= kMaxBeta &&
+           std::isfinite(Spacing) && Spacing > 0;
+}
+
+std::vector<double> sk::dsp::designPrototype(const FilterSpec &spec) {
+    if (!spec.valid())
+        throw std::runtime_error("invalid resampling filter spec");
+    const double denom = boost::math::cyl_bessel_i(0.0, spec.Beta);
+    const auto halfSize = static_cast<std::int64_t>(spec.Taps / 2);
+    const double gain = spec.Up / spec.Spacing;
+    std::vector<double> h(spec.Taps);
+    for (std::int64_t k = -halfSize; k <= halfSize; k++) {
+        const double x = static_cast<double>(k) / spec.Spacing;
+        if (k != 0 && x == std::round(x))
+            continue;
+        const double sinc =
+            (k == 0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+        const double normPos =
+            halfSize == 0 ? 0.5
+                          : static_cast<double>(k + halfSize) /
+                                (2.0 * static_cast<double>(halfSize));
+        double window = 0.0;
+        switch (spec.Window) {
+        case WindowType::RECTANGULAR:
+            window = 1.0;
+            break;
+        case WindowType::HAMMING:
+            window = 0.54 - 0.46 * std::cos(2.0 * M_PI * normPos);
+            break;
+        case WindowType::HANNING:
+            window = 0.5 * (1.0 + std::cos(2.0 * M_PI * normPos - M_PI));
+            break;
+        case WindowType::BLACKMAN:
+            window = 0.42 - 0.5 * std::cos(2.0 * M_PI * normPos) +
+                     0.08 * std::cos(4.0 * M_PI * normPos);
+            break;
+        case WindowType::KAISER:
+            const double r = 2.0 * normPos - 1.0;
+            window = boost::math::cyl_bessel_i(
+                         0.0, spec.Beta * std::sqrt(1.0 - r * r)) /
+                     denom;
+            break;
+        }
+        h[k + halfSize] = gain * sinc * window;
+    }
+    return h;
+}
+
+sk::dsp::FilterSpec sk::dsp::resamplingSpec(std::size_t up,
+                                            std::size_t down,
+                                            ResampleQuality quality) {
+    const bool high = quality == ResampleQuality::High;
+    const double pass = high ? 0.475 : 0.44;
+    const double stop = 0.5;
+    const double attenuation = high ? 140 : 100;
+    // The prototype runs at L × the input rate, where the lower rate is
+    // 1 / max(L, M); the cutoff sits midway through the transition.
+    const auto scale = static_cast<double>(std::max(up, down));
+    FilterSpec spec;
+    spec.Up = static_cast<std::uint32_t>(up);
+    spec.Down = static_cast<std::uint32_t>(down);
+    spec.Taps = static_cast<std::uint32_t>(
+        kaiserLength(attenuation, (stop - pass) / scale) / 2 * 2 + 1);
+    spec.Window = WindowType::KAISER;
+    spec.Beta = kaiserBeta(attenuation);
+    spec.Spacing = scale / (pass + stop);
+    return spec;
+}
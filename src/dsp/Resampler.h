@@ -0,0 +1,109 @@
+#pragma once
+#ifndef SINEKIT_RESAMPLER_H
+#define SINEKIT_RESAMPLER_H
+
+#include "../AudioTypes.h"
+#include "OverlapSave.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace sk::dsp {
+
+// ── Rational L/M FIR resampling, polyphase ───────────────────────────────
+// Resampling by L/M is zero stuffing by L, a lowpass at L × the input
+// rate, and keeping every M‑th sample, but L − 1 of every L stuffed samples
+// are zero and all but one in M results are dropped.  The prototype is
+// therefore split into phases, phase p holding taps p, p + L, p + 2L, …:
+// output k lands on stuffed sample kM = nL + p and is the dot product of
+// phase p with the input around n.  Only real input samples are multiplied
+// and only kept outputs are computed, so the cost per output is the
+// prototype length over L whatever the ratio.
+//
+// Only the phases output positions reach are kept: those p that are
+// multiples of gcd(L, M).  They are zero padded to a common, SIMD friendly
+// length, and the input is zero padded at both ends so the edges need no
+// branches.
+//
+// Long phases go through an OverlapSave bank instead, when its estimated
+// cost is lower.  The bank computes every phase at every input position,
+// M / L positions per output, but its cost per position grows only with
+// the log of the taps, so long prototypes run at a near constant cost.
+class Resampler {
+  public:
+    // The prototype is an odd‑length linear phase lowpass at L × the input
+    // rate, centred on its middle tap, with a passband gain of L.
+    Resampler(std::size_t up, std::size_t down,
+              const std::vector<double> &prototype);
+
+    [[nodiscard]] std::size_t up() const noexcept { return Up_; }
+    [[nodiscard]] std::size_t down() const noexcept { return Down_; }
+    // Taps per output sample.
+    [[nodiscard]] std::size_t taps() const noexcept { return Taps_; }
+    // Whether run() goes through the FFT bank.
+    [[nodiscard]] bool usesFFT() const noexcept { return Fast_.has_value(); }
+    // Output samples for n input samples, n × L / M rounded up.
+    [[nodiscard]] std::uint64_t outputLength(std::uint64_t n) const noexcept {
+        return (n * Up_ + Down_ - 1) / Down_;
+    }
+
+    // Resample n samples into outputLength(n), taking the signal to be
+    // zero beyond both ends.  The output is aligned with the input.
+    void run(const double *in, std::size_t n, double *out) const;
+
+  private:
+    std::size_t Up_;
+    std::size_t Down_;
+    // gcd(L, M): phase p is stored at p / Step_.
+    std::size_t Step_;
+    // Input samples each phase reaches back before n.
+    std::size_t Reach_;
+    std::size_t Taps_;
+    // L / Step_ phases of Taps_ each, coefficients in input order.
+    std::vector<double> Phases_;
+    std::optional<OverlapSave> Fast_;
+};
+
+// ── Resampling prototypes ────────────────────────────────────────────────
+// A windowed sinc at L × the input rate, fully described by its spec so
+// designs can be cached and shared.  Taps k = −c … c, c = (Taps − 1) / 2,
+// are (L / Spacing) × sinc(k / Spacing) × w(k / c), Spacing being the taps
+// between the sinc's zero crossings, 1 / (2 × cutoff).  Taps that fall on
+// a zero crossing are exactly zero, so with Spacing = L the input samples
+// pass through unchanged.
+struct FilterSpec {
+    std::uint32_t Up{1};
+    std::uint32_t Down{1};
+    std::uint32_t Taps{1};
+    WindowType Window{WindowType::KAISER};
+    // Kaiser β; unused by the other windows.
+    double Beta{0};
+    double Spacing{1};
+
+    // Largest Taps, Up or Down a spec may have, far beyond any real
+    // design; it keeps a corrupt spec from sizing huge tables.
+    static constexpr std::uint32_t kMaxTaps = 1u << 24;
+
+    // Odd Taps and nonzero Up and Down within kMaxTaps, a known window,
+    // and finite Beta and Spacing, Beta within what I0 can evaluate and
+    // Spacing positive.  Only valid specs order totally, so only they may
+    // key a map.
+    [[nodiscard]] bool valid() const noexcept;
+
+    auto operator<=>(const FilterSpec &) const = default;
+};
+
+// Throws for a spec that is not valid().
+[[nodiscard]] std::vector<double> designPrototype(const FilterSpec &spec);
+
+// Kaiser spec for L/M.  The passband and stopband edges are fractions of
+// the lower of the two rates: Standard passes 0.44 and stops 100 dB by
+// 0.5; High is the steep mastering filter, flat to 0.475 and 140 dB down
+// by 0.5.  Meant for L and M reduced by their gcd.
+[[nodiscard]] FilterSpec resamplingSpec(std::size_t up, std::size_t down,
+                                        ResampleQuality quality);
+
+} // namespace sk::dsp
+
+#endif // SINEKIT_RESAMPLER_H
@@ -5,12 +5,21 @@
 #include "AIFFHeaders.h"
 #include "../lib/EndianHelpers.h"
 
+#include <algorithm>
+#include <cstring>
+
 void sk::headers::AIFF::FORMHeader::read(std::ifstream &file) {
     file.read(ChunkID.v, sizeof(ChunkID.v));
     ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
     file.read(FormType.v, sizeof(FormType.v));
 }
 
+void sk::headers::AIFF::FORMHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readBE<decltype(ChunkSize)>();
+    bytes.read(FormType.v, sizeof(FormType.v));
+}
+
 void sk::headers::AIFF::FORMHeader::write(std::ofstream &file) const {
     file.write(ChunkID.v, sizeof(ChunkID.v));
     sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
@@ -35,6 +44,15 @@ void sk::headers::AIFF::COMMHeader::read(std::ifstream &file) {
     file.read(reinterpret_cast<char *>(&SampleRate), sizeof(SampleRate));
 }
 
+void sk::headers::AIFF::COMMHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readBE<decltype(ChunkSize)>();
+    NumChannels = bytes.readBE<decltype(NumChannels)>();
+    NumSamples = bytes.readBE<decltype(NumSamples)>();
+    BitDepth = bytes.readBE<decltype(BitDepth)>();
+    bytes.read(reinterpret_cast<char *>(&SampleRate), sizeof(SampleRate));
+}
+
 void sk::headers::AIFF::COMMHeader::write(std::ofstream &file) const {
     file.write(ChunkID.v, sizeof(ChunkID.v));
     sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
@@ -63,10 +81,28 @@ void sk::headers::AIFF::SSNDHeader::read(std::ifstream &file) {
     BlockSize = sk::endian::read_be<decltype(BlockSize)>(file);
 }
 
+void sk::headers::AIFF::SSNDHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readBE<decltype(ChunkSize)>();
+    Offset = bytes.readBE<decltype(Offset)>();
+    BlockSize = bytes.readBE<decltype(BlockSize)>();
+}
+
 void sk::headers::AIFF::COMMCompressionHeader::read(std::ifstream &file) {
     file.read(CompType.v, sizeof(CompType.v));
     CompName.Size = sk::endian::read_be<decltype(CompName.Size)>(file);
-    file.read(CompType.v, sizeof(CompType.v));
+    std::fill(std::begin(CompName.v), std::end(CompName.v), 0);
+    file.read(CompName.v, std::min<std::size_t>(CompName.Size,
+                                                sizeof(CompName.v) - 1));
+}
+
+void sk::headers::AIFF::COMMCompressionHeader::read(
+    sk::bytes::ByteReader &bytes) {
+    bytes.read(CompType.v, sizeof(CompType.v));
+    CompName.Size = bytes.readBE<decltype(CompName.Size)>();
+    std::fill(std::begin(CompName.v), std::end(CompName.v), 0);
+    bytes.read(CompName.v, std::min<std::size_t>(CompName.Size,
+                                                 sizeof(CompName.v) - 1));
 }
 
 void sk::headers::AIFF::SSNDHeader::write(std::ofstream &file) const {
@@ -83,66 +119,118 @@ void sk::headers::AIFF::COMMCompressionHeader::write(
     file.write(CompName.v, sizeof(CompName.v));
 }
 
-int verifyAIFFChunk(std::ifstream &file) {
-    char readData[4];
-    file.read(readData, sizeof(readData));
-    if (!file)
-        return false;
-    file.seekg(-4, std::ios::cur);
-    if (std::strncmp(readData, "FORM", 4) == 0)
-        return 1;
-    if (std::strncmp(readData, "COMM", 4) == 0)
-        return 2;
-    if (std::strncmp(readData, "SSND", 4) == 0)
-        return 3;
-    return 0;
+namespace {
+
+void validate(const sk::headers::AIFF::COMMHeader &comm) {
+    if (comm.NumChannels <= 0)
+        throw std::runtime_error("AIFF has no channels");
+    if (comm.BitDepth <= 0 || comm.BitDepth > 64)
+        throw std::runtime_error("unsupported AIFF sample size");
 }
 
+} // namespace
+
 void sk::headers::AIFF::AIFFHeader::read(std::ifstream &file) {
-    bool foundFORM = false;
+    form.read(file);
+    if (!file || std::strncmp(form.ChunkID.v, "FORM", 4) != 0)
+        throw std::runtime_error("not an IFF FORM file");
+    const bool readAIFC = std::strncmp(form.FormType.v, "AIFC", 4) == 0;
+
     bool foundCOMM = false;
     bool foundSSND = false;
-    bool readAIFC = false;
-    while (!foundFORM || !foundCOMM || !foundSSND) {
-        switch (verifyAIFFChunk(file)) {
-        case 1: {
-            if (!foundFORM) {
-                foundFORM = true;
-                form.read(file);
-                if (std::strncmp(form.FormType.v, "AIFC", 4) == 0) {
-                    readAIFC = true;
-                }
-                break;
-            }
-            throw std::runtime_error(
-                "Multiple FORM headers found, invalid file");
-        }
-        case 2: {
-            if (!foundCOMM) {
-                foundCOMM = true;
-                comm.read(file);
-                if (readAIFC) {
-                    comp.read(file);
-                }
+    std::streamoff payload = 0;
+    while (!foundCOMM || !foundSSND) {
+        const std::streamoff start = file.tellg();
+        Tag id;
+        file.read(id.v, sizeof(id.v));
+        const auto size = sk::endian::read_be<std::uint32_t>(file);
+        if (!file)
+            throw std::runtime_error("AIFF COMM/SSND chunk not found");
+        file.seekg(start);
+
+        if (std::strncmp(id.v, "COMM", 4) == 0) {
+            if (foundCOMM)
+                throw std::runtime_error(
+                    "Multiple COMM headers found, invalid file");
+            foundCOMM = true;
+            comm.read(file);
+            if (readAIFC)
+                comp.read(file);
+        } else if (std::strncmp(id.v, "SSND", 4) == 0) {
+            if (foundSSND)
+                throw std::runtime_error(
+                    "Multiple SSND headers found, invalid file");
+            foundSSND = true;
+            ssnd.read(file);
+            payload = file.tellg() + std::streamoff{ssnd.Offset};
+            if (foundCOMM)
                 break;
-            }
-            throw std::runtime_error(
-                "Multiple COMM headers found, invalid file");
         }
-        case 3: {
-            if (!foundSSND) {
-                foundSSND = true;
-                ssnd.read(file);
+        file.seekg(start + 8 + size + (size & 1));
+    }
+    validate(comm);
+    file.seekg(payload);
+    if (!file)
+        throw std::runtime_error("AIFF header read failed");
+    littleEndian = byteOrder() == endian::Endian::Little;
+}
+
+void sk::headers::AIFF::AIFFHeader::read(sk::bytes::ByteReader &bytes) {
+    form.read(bytes);
+    if (std::strncmp(form.ChunkID.v, "FORM", 4) != 0)
+        throw std::runtime_error("not an IFF FORM file");
+    const bool readAIFC = std::strncmp(form.FormType.v, "AIFC", 4) == 0;
+
+    bool foundCOMM = false;
+    bool foundSSND = false;
+    std::size_t payload = 0;
+    // COMM may legally follow SSND, so remember where the samples start and
+    // keep walking until both chunks have been seen.
+    while (!foundCOMM || !foundSSND) {
+        if (bytes.remaining() < 8)
+            throw std::runtime_error("AIFF COMM/SSND chunk not found");
+        const std::size_t start = bytes.tell();
+        bytes.skip(4);
+        const auto size = bytes.readBE<std::uint32_t>();
+        bytes.seek(start);
+
+        if (bytes.peekTag("COMM")) {
+            if (foundCOMM)
+                throw std::runtime_error(
+                    "Multiple COMM headers found, invalid file");
+            foundCOMM = true;
+            comm.read(bytes);
+            if (readAIFC)
+                comp.read(bytes);
+        } else if (bytes.peekTag("SSND")) {
+            if (foundSSND)
+                throw std::runtime_error(
+                    "Multiple SSND headers found, invalid file");
+            foundSSND = true;
+            ssnd.read(bytes);
+            payload = bytes.tell() + ssnd.Offset;
+            if (foundCOMM)
                 break;
-            }
-            throw std::runtime_error(
-                "Multiple SSND headers found, invalid file");
-        }
-        default: {
-            file.seekg(1, std::ios::cur);
-        }
         }
+        bytes.seek(start + 8 + size + (size & 1));
     }
+    validate(comm);
+    bytes.seek(payload);
+    littleEndian = byteOrder() == endian::Endian::Little;
+}
+
+sk::endian::Endian
+sk::headers::AIFF::AIFFHeader::byteOrder() const noexcept {
+    if (std::strncmp(form.FormType.v, "AIFC", 4) == 0 &&
+        std::strncmp(comp.CompType.v, "sowt", 4) == 0)
+        return endian::Endian::Little;
+    return endian::Endian::Big;
+}
+
+bool sk::headers::AIFF::AIFFHeader::isFloat() const noexcept {
+    return std::strncmp(form.FormType.v, "AIFC", 4) == 0 &&
+           (std::strncmp(comp.CompType.v, "fl32", 4) == 0 ||
+            std::strncmp(comp.CompType.v, "fl64", 4) == 0);
 }
 
 std::ostream &
@@ -155,6 +243,8 @@ sk::headers::AIFF::operator<<(std::ostream &os,
 }
 
 void sk::headers::AIFF::AIFFHeader::write(std::ofstream &file) const {
+    if (oversize)
+        throw std::runtime_error("AIFF cannot hold more than 4 GiB of audio");
     form.write(file);
     comm.write(file);
     if (std::strncmp(form.FormType.v, "AIFC", 4) == 0) {
@@ -166,17 +256,19 @@ void sk::headers::AIFF::AIFFHeader::write(std::ofstream &file) const {
 void sk::headers::AIFF::AIFFHeader::update(std::uint16_t bitDepth,
                                            std::uint32_t sampleRate,
                                            std::uint16_t numChannels,
-                                           std::uint32_t numFrames,
+                                           std::uint64_t numFrames,
                                            bool isFloat) {
     // ─── COMM chunk ───────────────────────────────────────────────
     comm.BitDepth = static_cast<std::int16_t>(bitDepth);
     comm.SampleRate = static_cast<Float80>(
         sampleRate); // already 10 bytes (static‑asserted elsewhere)
     comm.NumChannels = static_cast<std::int16_t>(numChannels);
-    comm.NumSamples = numFrames;
+    comm.NumSamples = static_cast<std::uint32_t>(numFrames);
 
     // Uncompressed PCM ⇒ COMM payload is fixed at 18 bytes.
-    if (isFloat) {
+    // AIFF‑C adds the compression type and name.
+    const bool sowt = littleEndian && !isFloat;
+    if (isFloat || sowt) {
         comm.ChunkSize = 36;
     } else {
         comm.ChunkSize = 18;
@@ -187,6 +279,7 @@ void sk::headers::AIFF::AIFFHeader::update(std::uint16_t bitDepth,
     // Audio data size in bytes.
     const std::uint64_t soundBytes =
         static_cast<std::uint64_t>(bitDepth) * numChannels * numFrames / 8;
+    oversize = soundBytes > kMaxSoundBytes;
 
     // SSND payload = 8‑byte (<Offset><BlockSize>) prefix + raw samples.
     const std::uint64_t ssndPayloadSize = 8 /*Offset+BlockSize*/ + soundBytes;
@@ -217,11 +310,17 @@ void sk::headers::AIFF::AIFFHeader::update(std::uint16_t bitDepth,
         default:
             break;
         }
+    } else if (sowt) {
+        form.FormType = {{'A', 'I', 'F', 'C'}};
+        comp.CompType = {{'s', 'o', 'w', 't'}};
+        comp.CompName = {12,
+                         {'B', 'y', 't', 'e', '-', 's', 'w', 'a', 'p', 'p',
+                          'e', 'd', 0x00}};
     } else {
         form.FormType = {{'A', 'I', 'F', 'F'}};
     }
     form.ChunkSize = static_cast<std::uint32_t>(formSize);
 
     ssnd.ChunkID = {{'S', 'S', 'N', 'D'}};
-    ssnd.ChunkSize = soundBytes;
+    ssnd.ChunkSize = static_cast<std::uint32_t>(ssndPayloadSize);
 }
\ No newline at end of file
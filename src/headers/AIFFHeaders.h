@@ -5,7 +5,9 @@
 #ifndef AIFFHEADERS_H
 #define AIFFHEADERS_H
 
+#include "../lib/ByteReader.h"
 #include "../lib/CustomFloat.h"
+#include "../lib/EndianHelpers.h"
 #include "HeaderTags.h"
 
 namespace sk::headers::AIFF {
@@ -14,6 +16,7 @@ struct FORMHeader {
     std::uint32_t ChunkSize{0};
     headers::Tag FormType{{'A', 'I', 'F', 'F'}};
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 std::ostream &operator<<(std::ostream &os, const FORMHeader &input);
@@ -26,6 +29,7 @@ struct COMMHeader {
     std::int16_t BitDepth{0};
     Float80 SampleRate{0};
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 std::ostream &operator<<(std::ostream &os, const COMMHeader &input);
@@ -35,6 +39,7 @@ struct COMMCompressionHeader {
     headers::PascalString CompName{
         12, {'F', 'l', 'o', 'a', 't', ' ', '3', '2', '-', 'b', 'i', 't', 0x00}};
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 
@@ -44,18 +49,37 @@ struct SSNDHeader {
     std::uint32_t Offset{0};
     std::uint32_t BlockSize{0};
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 
+// Largest payload whose FORM size still fits in 32 bits with the biggest
+// COMM/SSND overhead SineKit writes.  AIFF has no 64‑bit extension.
+inline constexpr std::uint64_t kMaxSoundBytes = 0xFFFFFFFFull - 65;
+
 struct AIFFHeader {
     FORMHeader form;
     COMMHeader comm;
     COMMCompressionHeader comp;
     SSNDHeader ssnd;
+    // Set by update() when the audio does not fit; write() then refuses.
+    bool oversize{false};
+    // Integer PCM is written as AIFF‑C 'sowt' (little‑endian) when set.
+    // read() sets it for 'sowt' files so a rewrite keeps the byte order.
+    bool littleEndian{false};
+
+    // Byte order of the sample payload as described by the header.
+    [[nodiscard]] endian::Endian byteOrder() const noexcept;
+    // Whether the payload is AIFF‑C 'fl32' / 'fl64' floating point.
+    [[nodiscard]] bool isFloat() const noexcept;
+    // Both overloads walk the chunk list by declared size and leave the
+    // cursor on the first byte of the sample payload.  A COMM with no
+    // channels or a sample size outside 1–64 bits is rejected first.
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
     void update(std::uint16_t bitDepth, std::uint32_t sampleRate,
-                std::uint16_t numChannels, std::uint32_t numFrames,
+                std::uint16_t numChannels, std::uint64_t numFrames,
                 bool isFloat);
 };
 std::ostream &operator<<(std::ostream &os, const AIFFHeader &input);
@@ -0,0 +1,226 @@
+#include "DSDIFFHeaders.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Size of a chunk on disk: ID, 64‑bit size, payload and pad byte.
+std::uint64_t onDisk(std::uint64_t size) { return 12 + size + (size & 1); }
+
+} // namespace
+
+void sk::headers::DSDIFF::FRM8Header::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+    file.read(FormType.v, sizeof(FormType.v));
+}
+
+void sk::headers::DSDIFF::FRM8Header::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+    file.write(FormType.v, sizeof(FormType.v));
+}
+
+void sk::headers::DSDIFF::FVERHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+    Version = sk::endian::read_be<decltype(Version)>(file);
+}
+
+void sk::headers::DSDIFF::FVERHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+    sk::endian::write_be<decltype(Version)>(file, Version);
+}
+
+void sk::headers::DSDIFF::PROPHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+    file.read(PropType.v, sizeof(PropType.v));
+}
+
+void sk::headers::DSDIFF::PROPHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+    file.write(PropType.v, sizeof(PropType.v));
+}
+
+void sk::headers::DSDIFF::FSHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+    SampleRate = sk::endian::read_be<decltype(SampleRate)>(file);
+}
+
+void sk::headers::DSDIFF::FSHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+    sk::endian::write_be<decltype(SampleRate)>(file, SampleRate);
+}
+
+void sk::headers::DSDIFF::CHNLHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+    NumChannels = sk::endian::read_be<decltype(NumChannels)>(file);
+    if (ChunkSize < 2 + 4 * std::uint64_t{NumChannels})
+        throw std::runtime_error("DSDIFF CHNL chunk too small");
+    ChannelIDs.resize(NumChannels);
+    for (Tag &id : ChannelIDs)
+        file.read(id.v, sizeof(id.v));
+}
+
+void sk::headers::DSDIFF::CHNLHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+    sk::endian::write_be<decltype(NumChannels)>(file, NumChannels);
+    for (const Tag &id : ChannelIDs)
+        file.write(id.v, sizeof(id.v));
+}
+
+void sk::headers::DSDIFF::CMPRHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+    file.read(CompressionType.v, sizeof(CompressionType.v));
+    const auto count = static_cast<std::uint8_t>(file.get());
+    if (ChunkSize < 5u + count)
+        throw std::runtime_error("DSDIFF CMPR chunk too small");
+    CompressionName.assign(count, '\0');
+    file.read(CompressionName.data(), count);
+}
+
+void sk::headers::DSDIFF::CMPRHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+    file.write(CompressionType.v, sizeof(CompressionType.v));
+    file.put(static_cast<char>(CompressionName.size()));
+    file.write(CompressionName.data(),
+               static_cast<std::streamsize>(CompressionName.size()));
+    if (CompressionName.size() % 2 == 0)
+        file.put(0);
+}
+
+void sk::headers::DSDIFF::DSDDataHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_be<decltype(ChunkSize)>(file);
+}
+
+void sk::headers::DSDIFF::DSDDataHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_be<decltype(ChunkSize)>(file, ChunkSize);
+}
+
+void sk::headers::DSDIFF::DSDIFFHeader::read(std::ifstream &file) {
+    frm8.read(file);
+    if (!file || std::strncmp(frm8.ChunkID.v, "FRM8", 4) != 0 ||
+        std::strncmp(frm8.FormType.v, "DSD ", 4) != 0)
+        throw std::runtime_error("not a DSDIFF file");
+
+    // Chunks are walked by their declared sizes; anything not needed here
+    // (comments, ID3, markers, the DIIN edit master) is skipped.  PROP is
+    // the one container chunk and is descended into.
+    bool foundFS = false, foundCHNL = false;
+    std::streamoff propEnd = -1;
+    while (true) {
+        const std::streamoff start = file.tellg();
+        if (start >= propEnd)
+            propEnd = -1;
+        Tag id;
+        file.read(id.v, sizeof(id.v));
+        const auto size = sk::endian::read_be<std::uint64_t>(file);
+        if (!file)
+            throw std::runtime_error("DSDIFF DSD chunk not found");
+        file.seekg(start);
+        const std::streamoff end =
+            start + static_cast<std::streamoff>(onDisk(size));
+
+        if (std::strncmp(id.v, "FVER", 4) == 0) {
+            fver.read(file);
+        } else if (std::strncmp(id.v, "PROP", 4) == 0) {
+            prop.read(file);
+            if (!file || std::strncmp(prop.PropType.v, "SND ", 4) != 0)
+                throw std::runtime_error("DSDIFF: unsupported PROP chunk");
+            propEnd = end;
+            continue; // walk the sub‑chunks next
+        } else if (std::strncmp(id.v, "FS  ", 4) == 0 && propEnd >= 0) {
+            fs.read(file);
+            foundFS = true;
+        } else if (std::strncmp(id.v, "CHNL", 4) == 0 && propEnd >= 0) {
+            chnl.read(file);
+            foundCHNL = true;
+        } else if (std::strncmp(id.v, "CMPR", 4) == 0 && propEnd >= 0) {
+            cmpr.read(file);
+            if (std::strncmp(cmpr.CompressionType.v, "DSD ", 4) != 0)
+                throw std::runtime_error("DSDIFF: compressed audio (DST) "
+                                         "is not supported");
+        } else if (std::strncmp(id.v, "DST ", 4) == 0) {
+            throw std::runtime_error("DSDIFF: compressed audio (DST) is "
+                                     "not supported");
+        } else if (std::strncmp(id.v, "DSD ", 4) == 0) {
+            if (!foundFS || !foundCHNL)
+                throw std::runtime_error("DSDIFF DSD chunk before PROP chunk");
+            data.read(file);
+            if (!file || chnl.NumChannels == 0 || fs.SampleRate == 0)
+                throw std::runtime_error("DSDIFF: invalid sound properties");
+            return;
+        }
+        file.seekg(end);
+    }
+}
+
+void sk::headers::DSDIFF::DSDIFFHeader::write(std::ofstream &file) const {
+    frm8.write(file);
+    fver.write(file);
+    prop.write(file);
+    fs.write(file);
+    chnl.write(file);
+    cmpr.write(file);
+    data.write(file);
+}
+
+void sk::headers::DSDIFF::DSDIFFHeader::update(std::uint32_t sampleRate,
+                                               std::uint16_t numChannels,
+                                               std::uint64_t numSamples) {
+    if (numChannels == 0)
+        throw std::runtime_error("DSDIFF needs at least one channel");
+    fver.ChunkSize = 4;
+    fver.Version = 0x01050000;
+    fs.ChunkSize = 4;
+    fs.SampleRate = sampleRate;
+
+    // Loudspeaker IDs from the specification for the layouts it names;
+    // anything else is numbered.
+    static constexpr Tag kStereo[] = {{{'S', 'L', 'F', 'T'}},
+                                      {{'S', 'R', 'G', 'T'}}};
+    static constexpr Tag kMulti[] = {
+        {{'M', 'L', 'F', 'T'}}, {{'M', 'R', 'G', 'T'}}, {{'C', ' ', ' ', ' '}},
+        {{'L', 'F', 'E', ' '}}, {{'L', 'S', ' ', ' '}}, {{'R', 'S', ' ', ' '}}};
+    chnl.NumChannels = numChannels;
+    chnl.ChunkSize = 2 + 4 * std::uint64_t{numChannels};
+    chnl.ChannelIDs.resize(numChannels);
+    for (std::uint16_t c = 0; c < numChannels; ++c) {
+        Tag &id = chnl.ChannelIDs[c];
+        if (numChannels == 1)
+            id = {{'C', ' ', ' ', ' '}};
+        else if (numChannels == 2)
+            id = kStereo[c];
+        else if (numChannels == 6 || (numChannels == 5 && c < 3))
+            id = kMulti[c];
+        else if (numChannels == 5)
+            id = kMulti[c + 1];
+        else
+            id = {{'C', static_cast<char>('0' + c / 100 % 10),
+                   static_cast<char>('0' + c / 10 % 10),
+                   static_cast<char>('0' + c % 10)}};
+    }
+
+    cmpr.CompressionType = {{'D', 'S', 'D', ' '}};
+    cmpr.CompressionName = "not compressed";
+    const std::uint64_t name = 1 + cmpr.CompressionName.size();
+    cmpr.ChunkSize = 4 + name + (name & 1);
+
+    prop.ChunkSize = 4 + onDisk(fs.ChunkSize) + onDisk(chnl.ChunkSize) +
+                     onDisk(cmpr.ChunkSize);
+    data.ChunkSize = (numSamples + 7) / 8 * numChannels;
+    frm8.ChunkSize = 4 + onDisk(fver.ChunkSize) + onDisk(prop.ChunkSize) +
+                     onDisk(data.ChunkSize);
+}
@@ -0,0 +1,103 @@
+#ifndef DSDIFFHEADERS_H
+#define DSDIFFHEADERS_H
+
+#include "../lib/EndianHelpers.h"
+#include "HeaderTags.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DSDIFF 1.5: a big‑endian IFF variant with 64‑bit chunk sizes.  Chunks
+// are word aligned; a pad byte after an odd sized chunk is not counted in
+// its size.
+namespace sk::headers::DSDIFF {
+struct FRM8Header {
+    headers::Tag ChunkID = {{'F', 'R', 'M', '8'}};
+    std::uint64_t ChunkSize = 0;
+    headers::Tag FormType = {{'D', 'S', 'D', ' '}};
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+struct FVERHeader {
+    headers::Tag ChunkID = {{'F', 'V', 'E', 'R'}};
+    std::uint64_t ChunkSize = 4;
+    std::uint32_t Version = 0x01050000;
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+// Container for the FS, CHNL and CMPR chunks below.
+struct PROPHeader {
+    headers::Tag ChunkID = {{'P', 'R', 'O', 'P'}};
+    std::uint64_t ChunkSize = 0;
+    headers::Tag PropType = {{'S', 'N', 'D', ' '}};
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+struct FSHeader {
+    headers::Tag ChunkID = {{'F', 'S', ' ', ' '}};
+    std::uint64_t ChunkSize = 4;
+    std::uint32_t SampleRate = 0;
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+struct CHNLHeader {
+    headers::Tag ChunkID = {{'C', 'H', 'N', 'L'}};
+    std::uint64_t ChunkSize = 2;
+    std::uint16_t NumChannels = 0;
+    std::vector<headers::Tag> ChannelIDs;
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+// The name is a Pascal string padded to an even length; the pad is part
+// of the chunk.
+struct CMPRHeader {
+    headers::Tag ChunkID = {{'C', 'M', 'P', 'R'}};
+    std::uint64_t ChunkSize = 20;
+    headers::Tag CompressionType = {{'D', 'S', 'D', ' '}};
+    std::string CompressionName = "not compressed";
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+// Sound data: one byte per channel in turn, oldest sample in the MSB.
+struct DSDDataHeader {
+    headers::Tag ChunkID = {{'D', 'S', 'D', ' '}};
+    std::uint64_t ChunkSize = 0;
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+};
+
+struct DSDIFFHeader {
+    FRM8Header frm8;
+    FVERHeader fver;
+    PROPHeader prop;
+    FSHeader fs;
+    CHNLHeader chnl;
+    CMPRHeader cmpr;
+    DSDDataHeader data;
+
+    // DSDIFF counts whole bytes, so this is always a multiple of 8.
+    [[nodiscard]] std::uint64_t numSamples() const noexcept {
+        return chnl.NumChannels == 0
+                   ? 0
+                   : data.ChunkSize / chnl.NumChannels * 8;
+    }
+
+    // Walks the chunk list by declared size and leaves the cursor on the
+    // first byte of the sound data.  Throws on DST‑compressed files.
+    void read(std::ifstream &file);
+    void write(std::ofstream &file) const;
+    // Recomputes every size field for numSamples samples per channel
+    // (rounded up to whole bytes) and assigns the standard channel IDs.
+    void update(std::uint32_t sampleRate, std::uint16_t numChannels,
+                std::uint64_t numSamples);
+};
+} // namespace sk::headers::DSDIFF
+
+#endif // DSDIFFHEADERS_H
@@ -4,7 +4,9 @@
 
 #include "DSFHeaders.h"
 
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
 
 #include "../lib/EndianHelpers.h"
 
@@ -15,6 +17,13 @@ void sk::headers::DSF::DSDHeader::read(std::ifstream &file) {
     MetaPtr = sk::endian::read_le<decltype(MetaPtr)>(file);
 }
 
+void sk::headers::DSF::DSDHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readLE<decltype(ChunkSize)>();
+    FileSize = bytes.readLE<decltype(FileSize)>();
+    MetaPtr = bytes.readLE<decltype(MetaPtr)>();
+}
+
 void sk::headers::DSF::DSDHeader::write(std::ofstream &file) const {
     file.write(ChunkID.v, sizeof(ChunkID.v));
     sk::endian::write_le<decltype(ChunkSize)>(file, ChunkSize);
@@ -34,4 +43,161 @@ void sk::headers::DSF::FMTHeader::read(std::ifstream &file) {
     NumSamples = sk::endian::read_le<decltype(NumSamples)>(file);
     BlockSize = sk::endian::read_le<decltype(BlockSize)>(file);
     Reserved = sk::endian::read_le<decltype(Reserved)>(file);
-}
\ No newline at end of file
+}
+
+void sk::headers::DSF::FMTHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readLE<decltype(ChunkSize)>();
+    Format = bytes.readLE<decltype(Format)>();
+    FormatID = bytes.readLE<decltype(FormatID)>();
+    ChanType = bytes.readLE<decltype(ChanType)>();
+    ChanNum = bytes.readLE<decltype(ChanNum)>();
+    SampleRate = bytes.readLE<decltype(SampleRate)>();
+    BitsPerSample = bytes.readLE<decltype(BitsPerSample)>();
+    NumSamples = bytes.readLE<decltype(NumSamples)>();
+    BlockSize = bytes.readLE<decltype(BlockSize)>();
+    Reserved = bytes.readLE<decltype(Reserved)>();
+}
+
+void sk::headers::DSF::FMTHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_le<decltype(ChunkSize)>(file, ChunkSize);
+    sk::endian::write_le<decltype(Format)>(file, Format);
+    sk::endian::write_le<decltype(FormatID)>(file, FormatID);
+    sk::endian::write_le<decltype(ChanType)>(file, ChanType);
+    sk::endian::write_le<decltype(ChanNum)>(file, ChanNum);
+    sk::endian::write_le<decltype(SampleRate)>(file, SampleRate);
+    sk::endian::write_le<decltype(BitsPerSample)>(file, BitsPerSample);
+    sk::endian::write_le<decltype(NumSamples)>(file, NumSamples);
+    sk::endian::write_le<decltype(BlockSize)>(file, BlockSize);
+    sk::endian::write_le<decltype(Reserved)>(file, Reserved);
+}
+
+void sk::headers::DSF::DATAHeader::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_le<decltype(ChunkSize)>(file);
+}
+
+void sk::headers::DSF::DATAHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readLE<decltype(ChunkSize)>();
+}
+
+void sk::headers::DSF::DATAHeader::write(std::ofstream &file) const {
+    file.write(ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_le<decltype(ChunkSize)>(file, ChunkSize);
+}
+
+namespace {
+
+void validate(const sk::headers::DSF::DSFHeader &header) {
+    const auto &fmt = header.fmt;
+    if (fmt.FormatID != 0)
+        throw std::runtime_error("DSF: only raw DSD is supported");
+    if (fmt.BitsPerSample != 1 && fmt.BitsPerSample != 8)
+        throw std::runtime_error("DSF: invalid bits per sample");
+    if (fmt.ChanNum == 0 || fmt.BlockSize == 0)
+        throw std::runtime_error("DSF: invalid channel layout");
+    if (header.data.ChunkSize < 12)
+        throw std::runtime_error("DSF: invalid data chunk size");
+}
+
+} // namespace
+
+void sk::headers::DSF::DSFHeader::read(std::ifstream &file) {
+    dsd.read(file);
+    if (!file || std::strncmp(dsd.ChunkID.v, "DSD ", 4) != 0)
+        throw std::runtime_error("not a DSF file");
+    file.seekg(static_cast<std::streamoff>(dsd.ChunkSize));
+
+    bool foundFMT = false;
+    while (true) {
+        const std::streamoff start = file.tellg();
+        Tag id;
+        file.read(id.v, sizeof(id.v));
+        const auto size = sk::endian::read_le<std::uint64_t>(file);
+        if (!file)
+            throw std::runtime_error("DSF DATA chunk not found");
+        file.seekg(start);
+
+        if (std::strncmp(id.v, "fmt ", 4) == 0) {
+            foundFMT = true;
+            fmt.read(file);
+        } else if (std::strncmp(id.v, "data", 4) == 0) {
+            if (!foundFMT)
+                throw std::runtime_error("DSF DATA chunk before FMT chunk");
+            data.read(file);
+            validate(*this);
+            return;
+        }
+        if (size < 12)
+            throw std::runtime_error("DSF chunk size out of range");
+        file.seekg(start + static_cast<std::streamoff>(size));
+    }
+}
+
+void sk::headers::DSF::DSFHeader::read(sk::bytes::ByteReader &bytes) {
+    dsd.read(bytes);
+    if (std::strncmp(dsd.ChunkID.v, "DSD ", 4) != 0)
+        throw std::runtime_error("not a DSF file");
+    bytes.seek(static_cast<std::size_t>(dsd.ChunkSize));
+
+    bool foundFMT = false;
+    while (true) {
+        if (bytes.remaining() < 12)
+            throw std::runtime_error("DSF DATA chunk not found");
+        const std::size_t start = bytes.tell();
+        bytes.skip(4);
+        const auto size = bytes.readLE<std::uint64_t>();
+        bytes.seek(start);
+
+        if (bytes.peekTag("fmt ")) {
+            foundFMT = true;
+            fmt.read(bytes);
+        } else if (bytes.peekTag("data")) {
+            if (!foundFMT)
+                throw std::runtime_error("DSF DATA chunk before FMT chunk");
+            data.read(bytes);
+            validate(*this);
+            return;
+        }
+        if (size < 12 || size > bytes.remaining())
+            throw std::runtime_error("DSF chunk size out of range");
+        bytes.seek(start + static_cast<std::size_t>(size));
+    }
+}
+
+void sk::headers::DSF::DSFHeader::write(std::ofstream &file) const {
+    dsd.write(file);
+    fmt.write(file);
+    data.write(file);
+}
+
+void sk::headers::DSF::DSFHeader::update(std::uint32_t sampleRate,
+                                         std::uint16_t numChannels,
+                                         std::uint64_t numSamples) {
+    // Channel type codes from the DSF specification: 1 mono, 2 stereo,
+    // 3 three channels, 4 quad, 6 five channels, 7 5.1.
+    static constexpr std::uint32_t kChanType[] = {0, 1, 2, 3, 4, 6, 7};
+    if (numChannels == 0 || numChannels > 6)
+        throw std::runtime_error("DSF supports 1 to 6 channels");
+
+    fmt.ChunkSize = 52;
+    fmt.Format = 1;
+    fmt.FormatID = 0;
+    fmt.ChanType = kChanType[numChannels];
+    fmt.ChanNum = numChannels;
+    fmt.SampleRate = sampleRate;
+    fmt.BitsPerSample = 1;
+    fmt.NumSamples = numSamples;
+    fmt.BlockSize = 4096;
+    fmt.Reserved = 0;
+
+    const std::uint64_t bytesPerChannel = (numSamples + 7) / 8;
+    const std::uint64_t groups =
+        (bytesPerChannel + fmt.BlockSize - 1) / fmt.BlockSize;
+    data.ChunkSize = 12 + groups * groupSize();
+    dsd.ChunkSize = 28;
+    dsd.MetaPtr = 0;
+    dsd.FileSize = dsd.ChunkSize + fmt.ChunkSize + data.ChunkSize;
+}
@@ -5,8 +5,10 @@
 #ifndef DSFHEADERS_H
 #define DSFHEADERS_H
 
+#include "../lib/ByteReader.h"
 #include "HeaderTags.h"
 #include <cstdint>
+#include <fstream>
 
 namespace sk::headers::DSF {
 struct DSDHeader {
@@ -15,6 +17,7 @@ struct DSDHeader {
     std::uint64_t FileSize = 0;
     std::uint64_t MetaPtr = 0;
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 
@@ -31,8 +34,49 @@ struct FMTHeader {
     std::uint32_t BlockSize = 4096;
     std::uint32_t Reserved = 0;
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
+
+// ChunkSize counts the 12‑byte chunk header as well as the sample data.
+struct DATAHeader {
+    headers::Tag ChunkID = {{'d', 'a', 't', 'a'}};
+    std::uint64_t ChunkSize = 12;
+    void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
+    void write(std::ofstream &file) const;
+};
+
+// The sample data is a sequence of block groups: one BlockSize‑byte block
+// per channel, channel after channel, with the last group zero padded.
+// BitsPerSample 1 stores the oldest sample in the least significant bit,
+// 8 in the most significant one.
+struct DSFHeader {
+    DSDHeader dsd;
+    FMTHeader fmt;
+    DATAHeader data;
+
+    [[nodiscard]] bool lsbFirst() const noexcept {
+        return fmt.BitsPerSample == 1;
+    }
+    // Bytes in one block group, and the payload bytes the data chunk holds.
+    [[nodiscard]] std::uint64_t groupSize() const noexcept {
+        return std::uint64_t{fmt.BlockSize} * fmt.ChanNum;
+    }
+    [[nodiscard]] std::uint64_t dataSize() const noexcept {
+        return data.ChunkSize - 12;
+    }
+
+    // Both overloads follow the chunk sizes and leave the cursor on the
+    // first byte of the sample data.
+    void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
+    void write(std::ofstream &file) const;
+    // Recomputes the format and every size field for numSamples 1‑bit
+    // samples per channel; any metadata pointer is dropped.
+    void update(std::uint32_t sampleRate, std::uint16_t numChannels,
+                std::uint64_t numSamples);
+};
 } // namespace sk::headers::DSF
 
 #endif // DSFHEADERS_H
@@ -4,6 +4,9 @@
 
 #include "WAVHeaders.h"
 
+#include <algorithm>
+#include <cstring>
+
 // ─── RIFF helpers ─────────────────────────────────────────────────────────
 void sk::headers::WAV::RIFFHeader::read(std::ifstream &file) {
     file.read(ChunkID.v, sizeof(ChunkID.v));
@@ -13,13 +16,75 @@ void sk::headers::WAV::RIFFHeader::read(std::ifstream &file) {
         throw std::runtime_error("RIFF header read failed");
 }
 
+void sk::headers::WAV::RIFFHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readLE<decltype(ChunkSize)>();
+    bytes.read(Format.v, sizeof(Format.v));
+}
+
 void sk::headers::WAV::RIFFHeader::write(std::ofstream &file) const {
     file.write(ChunkID.v, sizeof(ChunkID.v));
     sk::endian::write_le<decltype(ChunkSize)>(file, ChunkSize);
     file.write(Format.v, sizeof(Format.v));
 }
 
+// ─── DS64 helpers ─────────────────────────────────────────────────────────
+void sk::headers::WAV::DS64Header::read(std::ifstream &file) {
+    file.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = sk::endian::read_le<decltype(ChunkSize)>(file);
+    RIFFSize = sk::endian::read_le<decltype(RIFFSize)>(file);
+    DataSize = sk::endian::read_le<decltype(DataSize)>(file);
+    SampleCount = sk::endian::read_le<decltype(SampleCount)>(file);
+    TableLength = sk::endian::read_le<decltype(TableLength)>(file);
+    if (!file)
+        throw std::runtime_error("DS64 header read failed");
+}
+
+void sk::headers::WAV::DS64Header::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readLE<decltype(ChunkSize)>();
+    RIFFSize = bytes.readLE<decltype(RIFFSize)>();
+    DataSize = bytes.readLE<decltype(DataSize)>();
+    SampleCount = bytes.readLE<decltype(SampleCount)>();
+    TableLength = bytes.readLE<decltype(TableLength)>();
+}
+
+void sk::headers::WAV::DS64Header::write(std::ofstream &file,
+                                         bool asJunk) const {
+    file.write(asJunk ? "JUNK" : ChunkID.v, sizeof(ChunkID.v));
+    sk::endian::write_le<std::uint32_t>(file, 28);
+    sk::endian::write_le<decltype(RIFFSize)>(file, asJunk ? 0 : RIFFSize);
+    sk::endian::write_le<decltype(DataSize)>(file, asJunk ? 0 : DataSize);
+    sk::endian::write_le<decltype(SampleCount)>(file,
+                                                asJunk ? 0 : SampleCount);
+    sk::endian::write_le<decltype(TableLength)>(file, 0);
+}
+
 // ─── FMT helpers ──────────────────────────────────────────────────────────
+namespace {
+
+// cbSize, wValidBitsPerSample, dwChannelMask and the SubFormat GUID that
+// follow the 16 basic bytes of an extensible fmt chunk.  The GUIDs that
+// carry a format code are xxxxxxxx‑0000‑0010‑8000‑00AA00389B71 with the
+// code in the first word.
+void readExtension(sk::headers::WAV::FMTHeader &fmt,
+                   sk::bytes::ByteReader &bytes) {
+    static constexpr std::uint8_t kBase[12] = {0x00, 0x00, 0x10, 0x00,
+                                               0x80, 0x00, 0x00, 0xAA,
+                                               0x00, 0x38, 0x9B, 0x71};
+    bytes.skip(2);
+    fmt.ValidBits = bytes.readLE<std::uint16_t>();
+    fmt.ChannelMask = bytes.readLE<std::uint32_t>();
+    const auto code = bytes.readLE<std::uint32_t>();
+    char rest[12];
+    bytes.read(rest, sizeof rest);
+    fmt.SubFormat = code <= 0xFFFF && std::memcmp(rest, kBase, 12) == 0
+                        ? static_cast<std::uint16_t>(code)
+                        : 0;
+}
+
+} // namespace
+
 void sk::headers::WAV::FMTHeader::read(std::ifstream &file) {
     file.read(Subchunk1ID.v, sizeof(Subchunk1ID.v));
 
@@ -30,11 +95,33 @@ void sk::headers::WAV::FMTHeader::read(std::ifstream &file) {
     ByteRate = sk::endian::read_le<decltype(ByteRate)>(file);
     BlockAlign = sk::endian::read_le<decltype(BlockAlign)>(file);
     BitsPerSample = sk::endian::read_le<decltype(BitsPerSample)>(file);
+    if (AudioFormat == kExtensible && Subchunk1Size >= 40) {
+        char tail[24];
+        file.read(tail, sizeof tail);
+        if (file) {
+            bytes::ByteReader extension(
+                reinterpret_cast<const std::uint8_t *>(tail), sizeof tail);
+            readExtension(*this, extension);
+        }
+    }
 
     if (!file)
         throw std::runtime_error("FMTHeader header read failed");
 }
 
+void sk::headers::WAV::FMTHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(Subchunk1ID.v, sizeof(Subchunk1ID.v));
+    Subchunk1Size = bytes.readLE<decltype(Subchunk1Size)>();
+    AudioFormat = bytes.readLE<decltype(AudioFormat)>();
+    NumChannels = bytes.readLE<decltype(NumChannels)>();
+    SampleRate = bytes.readLE<decltype(SampleRate)>();
+    ByteRate = bytes.readLE<decltype(ByteRate)>();
+    BlockAlign = bytes.readLE<decltype(BlockAlign)>();
+    BitsPerSample = bytes.readLE<decltype(BitsPerSample)>();
+    if (AudioFormat == kExtensible && Subchunk1Size >= 40)
+        readExtension(*this, bytes);
+}
+
 void sk::headers::WAV::FMTHeader::write(std::ofstream &file) const {
     file.write(Subchunk1ID.v, sizeof(Subchunk1ID.v));
     sk::endian::write_le<decltype(Subchunk1Size)>(file, Subchunk1Size);
@@ -54,6 +141,12 @@ void sk::headers::WAV::FACTHeader::read(std::ifstream &file) {
         throw std::runtime_error("FACTHeader header read failed");
 }
 
+void sk::headers::WAV::FACTHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(ChunkID.v, sizeof(ChunkID.v));
+    ChunkSize = bytes.readLE<decltype(ChunkSize)>();
+    NumSamples = bytes.readLE<decltype(NumSamples)>();
+}
+
 void sk::headers::WAV::FACTHeader::write(std::ofstream &file) const {
     file.write(ChunkID.v, sizeof(ChunkID.v));
     sk::endian::write_le<decltype(ChunkSize)>(file, ChunkSize);
@@ -68,87 +161,128 @@ void sk::headers::WAV::WAVDataHeader::read(std::ifstream &file) {
         throw std::runtime_error("WAV DATA header read failed");
 }
 
+void sk::headers::WAV::WAVDataHeader::read(sk::bytes::ByteReader &bytes) {
+    bytes.read(Subchunk2ID.v, sizeof(Subchunk2ID.v));
+    Subchunk2Size = bytes.readLE<decltype(Subchunk2Size)>();
+}
+
 void sk::headers::WAV::WAVDataHeader::write(std::ofstream &file) const {
     file.write(Subchunk2ID.v, sizeof(Subchunk2ID.v));
     sk::endian::write_le<decltype(Subchunk2Size)>(file, Subchunk2Size);
 }
 
-int verifyWAVChunk(std::ifstream &file) {
-    char readData[4];
-    file.read(readData, sizeof(readData));
-    if (!file)
-        return false;
-    file.seekg(-4, std::ios::cur);
-    if (std::strncmp(readData, "RIFF", 4) == 0)
-        return 1;
-    if (std::strncmp(readData, "fmt ", 4) == 0)
-        return 2;
-    if (std::strncmp(readData, "fact", 4) == 0)
-        return 3;
-    if (std::strncmp(readData, "data", 4) == 0)
-        return 4;
-    return 0;
-}
 // ─── WAV HEADER helpers ───────────────────────────────────────────────────
+namespace {
+
+void validate(const sk::headers::WAV::FMTHeader &fmt) {
+    using sk::headers::WAV::FMTHeader;
+    if (fmt.formatCode() != FMTHeader::kPCM &&
+        fmt.formatCode() != FMTHeader::kFloat)
+        throw std::runtime_error("WAV is neither integer PCM nor float");
+    if (fmt.NumChannels == 0)
+        throw std::runtime_error("WAV has no channels");
+    if (fmt.BitsPerSample == 0 || fmt.BitsPerSample % 8 != 0 ||
+        fmt.BitsPerSample > 64)
+        throw std::runtime_error("unsupported WAV sample width");
+    if (fmt.BlockAlign != fmt.NumChannels * (fmt.BitsPerSample / 8))
+        throw std::runtime_error("WAV BlockAlign does not match its format");
+}
+
+} // namespace
+
 void sk::headers::WAV::WAVHeader::read(std::ifstream &file) {
-    bool foundRIFF = false;
+    riff.read(file);
+    if ((std::strncmp(riff.ChunkID.v, "RIFF", 4) != 0 && !isRF64()) ||
+        std::strncmp(riff.Format.v, "WAVE", 4) != 0)
+        throw std::runtime_error("not a RIFF/WAVE file");
+
     bool foundFMT = false;
-    bool foundFact = false;
-    bool foundData = false;
-    while (!foundRIFF || !foundFMT || !foundFact || !foundData) {
-        switch (verifyWAVChunk(file)) {
-        case 1: {
-            if (!foundRIFF) {
-                foundRIFF = true;
-                riff.read(file);
-                break;
-            }
-            throw std::runtime_error(
-                "Multiple RIFF headers found, invalid file");
-        }
-        case 2: {
-            if (!foundFMT) {
-                foundFMT = true;
-                fmt.read(file);
-                break;
-            }
-            throw std::runtime_error(
-                "Multiple FMT headers found, invalid file");
-        }
-        case 3: {
-            if (!foundFact) {
-                foundFact = true;
-                fact.read(file);
-                break;
-            }
-            throw std::runtime_error(
-                "Multiple FACT headers found, invalid file");
-        }
-        case 4: {
-            if (!foundData) {
-                foundData = true;
-                data.read(file);
-                break;
-            }
-            throw std::runtime_error(
-                "Multiple DATA headers found, invalid file");
-        }
-        default: {
-            file.seekg(2, std::ios::cur);
-            break;
-        }
+    while (true) {
+        const std::streamoff start = file.tellg();
+        Tag id;
+        file.read(id.v, sizeof(id.v));
+        const auto size = sk::endian::read_le<std::uint32_t>(file);
+        if (!file)
+            throw std::runtime_error("WAV DATA chunk not found");
+        file.seekg(start);
+
+        if (std::strncmp(id.v, "ds64", 4) == 0) {
+            ds64.read(file);
+        } else if (std::strncmp(id.v, "fmt ", 4) == 0) {
+            foundFMT = true;
+            fmt.read(file);
+        } else if (std::strncmp(id.v, "fact", 4) == 0) {
+            fact.read(file);
+        } else if (std::strncmp(id.v, "data", 4) == 0) {
+            if (!foundFMT)
+                throw std::runtime_error("WAV DATA chunk before FMT chunk");
+            data.read(file);
+            validate(fmt);
+            return;
         }
+        // Unknown chunks (LIST, bext, iXML, ...) are skipped by their
+        // declared size rather than scanned.
+        file.seekg(start + 8 + size + (size & 1));
+    }
+}
+
+void sk::headers::WAV::WAVHeader::read(sk::bytes::ByteReader &bytes) {
+    riff.read(bytes);
+    if ((std::strncmp(riff.ChunkID.v, "RIFF", 4) != 0 && !isRF64()) ||
+        std::strncmp(riff.Format.v, "WAVE", 4) != 0)
+        throw std::runtime_error("not a RIFF/WAVE file");
+
+    bool foundFMT = false;
+    while (true) {
+        if (bytes.remaining() < 8)
+            throw std::runtime_error("WAV DATA chunk not found");
+        const std::size_t start = bytes.tell();
+        bytes.skip(4);
+        const auto size = bytes.readLE<std::uint32_t>();
+        bytes.seek(start);
 
-        if (foundRIFF && foundFMT && foundData && fmt.AudioFormat != 3) {
-            foundFact = true;
+        if (bytes.peekTag("ds64")) {
+            ds64.read(bytes);
+        } else if (bytes.peekTag("fmt ")) {
+            foundFMT = true;
+            fmt.read(bytes);
+        } else if (bytes.peekTag("fact")) {
+            fact.read(bytes);
+        } else if (bytes.peekTag("data")) {
+            if (!foundFMT)
+                throw std::runtime_error("WAV DATA chunk before FMT chunk");
+            data.read(bytes);
+            validate(fmt);
+            return;
         }
+        // Chunks are word aligned; this also skips any extension bytes the
+        // structs above do not model (e.g. cbSize in an 18‑byte fmt chunk).
+        bytes.seek(start + 8 + size + (size & 1));
     }
 }
 
+bool sk::headers::WAV::WAVHeader::isRF64() const noexcept {
+    return std::strncmp(riff.ChunkID.v, "RF64", 4) == 0 ||
+           std::strncmp(riff.ChunkID.v, "BW64", 4) == 0;
+}
+
+std::uint64_t sk::headers::WAV::WAVHeader::dataSize() const noexcept {
+    if (isRF64() && data.Subchunk2Size == kSizeInDS64)
+        return ds64.DataSize;
+    return data.Subchunk2Size;
+}
+
+std::uint64_t sk::headers::WAV::WAVHeader::numFrames() const noexcept {
+    return fmt.BlockAlign == 0 ? 0 : dataSize() / fmt.BlockAlign;
+}
+
 void sk::headers::WAV::WAVHeader::write(std::ofstream &file) const {
     riff.write(file);
+    if (isRF64() || reserveDS64) {
+        ds64.write(file, !isRF64());
+    }
     fmt.write(file);
-    if (fmt.AudioFormat == 3) {
+    if (fmt.AudioFormat == FMTHeader::kFloat) {
         fact.write(file);
     }
     data.write(file);
@@ -157,18 +291,43 @@ void sk::headers::WAV::WAVHeader::write(std::ofstream &file) const {
 void sk::headers::WAV::WAVHeader::update(std::uint16_t bitDepth,
                                          std::uint32_t sampleRate,
                                          std::uint16_t numChannels,
-                                         std::uint32_t numFrames,
+                                         std::uint64_t numFrames,
                                          bool isFloat) {
-    fmt.AudioFormat = isFloat ? 3 : 1;
+    fmt.Subchunk1Size = 16;
+    fmt.AudioFormat = isFloat ? FMTHeader::kFloat : FMTHeader::kPCM;
+    fmt.ValidBits = 0;
+    fmt.ChannelMask = 0;
+    fmt.SubFormat = 0;
     fmt.NumChannels = numChannels;
     fmt.SampleRate = sampleRate;
     fmt.BlockAlign = numChannels * bitDepth / 8;
     fmt.ByteRate = sampleRate * fmt.BlockAlign;
     fmt.BitsPerSample = bitDepth;
 
-    fact.NumSamples = numFrames;
+    const std::uint64_t dataBytes = numFrames * fmt.BlockAlign;
+    // ds64 (or its JUNK placeholder) is 8 + 28 bytes; the data chunk
+    // carries a pad byte when its size is odd.
+    const std::uint64_t riffBytes =
+        4 + (8 + fmt.Subchunk1Size) + (8 + dataBytes + (dataBytes & 1)) +
+        (fmt.AudioFormat == FMTHeader::kFloat ? 12 : 0) +
+        (reserveDS64 ? 36 : 0);
+    const bool promote = riffBytes > kSizeInDS64;
+    const std::uint64_t fullRiffBytes = riffBytes + (reserveDS64 ? 0 : 36);
 
-    data.Subchunk2Size = numFrames * fmt.BlockAlign;
-    riff.ChunkSize = 4 + (8 + fmt.Subchunk1Size) + (8 + data.Subchunk2Size) +
-                     (fmt.AudioFormat == 3 ? 12 : 0);
+    if (promote) {
+        riff.ChunkID = {{'R', 'F', '6', '4'}};
+        riff.ChunkSize = kSizeInDS64;
+        data.Subchunk2Size = kSizeInDS64;
+        ds64.RIFFSize = fullRiffBytes;
+        ds64.DataSize = dataBytes;
+        ds64.SampleCount = numFrames;
+        ds64.TableLength = 0;
+        fact.NumSamples = static_cast<std::uint32_t>(
+            std::min<std::uint64_t>(numFrames, kSizeInDS64));
+    } else {
+        riff.ChunkID = {{'R', 'I', 'F', 'F'}};
+        riff.ChunkSize = static_cast<std::uint32_t>(riffBytes);
+        data.Subchunk2Size = static_cast<std::uint32_t>(dataBytes);
+        fact.NumSamples = static_cast<std::uint32_t>(numFrames);
+    }
 }
@@ -5,6 +5,7 @@
 #ifndef WAVHEADERS_H
 #define WAVHEADERS_H
 
+#include "../lib/ByteReader.h"
 #include "../lib/EndianHelpers.h"
 #include "HeaderTags.h"
 #include <fstream>
@@ -17,10 +18,28 @@ struct RIFFHeader {
     Tag Format{{'W', 'A', 'V', 'E'}};
 
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 std::ostream &operator<<(std::ostream &os, const RIFFHeader &input);
 
+// RF64 / BW64 (EBU Tech 3306 / ITU‑R BS.2088) size extension.  When a file
+// is promoted the 32‑bit RIFF and data sizes are set to 0xFFFFFFFF and the
+// real 64‑bit values live here.
+struct DS64Header {
+    Tag ChunkID{{'d', 's', '6', '4'}};
+    std::uint32_t ChunkSize{28};
+    std::uint64_t RIFFSize{0};
+    std::uint64_t DataSize{0};
+    std::uint64_t SampleCount{0};
+    std::uint32_t TableLength{0};
+    void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
+    // Writes either the ds64 chunk or, for a plain RIFF file, a JUNK chunk
+    // of the same size that can later be turned into one in place.
+    void write(std::ofstream &file, bool asJunk) const;
+};
+
 struct FMTHeader {
     Tag Subchunk1ID{{'f', 'm', 't', ' '}};
     std::uint32_t Subchunk1Size{16};
@@ -30,7 +49,24 @@ struct FMTHeader {
     std::uint32_t ByteRate{0};
     std::uint16_t BlockAlign{0};
     std::uint16_t BitsPerSample{0};
+    // WAVE_FORMAT_EXTENSIBLE (AudioFormat 0xFFFE) moves the real format
+    // code into a SubFormat GUID.  Read only; write() always emits the
+    // plain 16‑byte form.  SubFormat is 0 when the GUID is not one of the
+    // KSDATAFORMAT_SUBTYPE family built on a format code.
+    std::uint16_t ValidBits{0};
+    std::uint32_t ChannelMask{0};
+    std::uint16_t SubFormat{0};
+
+    static constexpr std::uint16_t kPCM = 1;
+    static constexpr std::uint16_t kFloat = 3;
+    static constexpr std::uint16_t kExtensible = 0xFFFE;
+
+    // The format code, looked up in SubFormat for an extensible header.
+    [[nodiscard]] std::uint16_t formatCode() const noexcept {
+        return AudioFormat == kExtensible ? SubFormat : AudioFormat;
+    }
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 std::ostream &operator<<(std::ostream &os, const FMTHeader &input);
@@ -40,6 +76,7 @@ struct FACTHeader {
     std::uint32_t ChunkSize{4};
     std::uint32_t NumSamples{0};
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 
@@ -47,19 +84,45 @@ struct WAVDataHeader {
     Tag Subchunk2ID{{'d', 'a', 't', 'a'}};
     std::uint32_t Subchunk2Size{0};
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
 };
 std::ostream &operator<<(std::ostream &os, const WAVDataHeader &input);
 
 struct WAVHeader {
     RIFFHeader riff;
+    DS64Header ds64;
     FMTHeader fmt;
     FACTHeader fact;
     WAVDataHeader data;
+    // Reserve room for a ds64 chunk even while the file fits in plain RIFF,
+    // so a writer that only learns the final size at the end can still
+    // promote to RF64 without moving the payload.
+    bool reserveDS64{false};
+
+    static constexpr std::uint32_t kSizeInDS64 = 0xFFFFFFFF;
+
+    [[nodiscard]] bool isRF64() const noexcept;
+    // Whether the payload is IEEE float, plain or extensible.
+    [[nodiscard]] bool isFloat() const noexcept {
+        return fmt.formatCode() == FMTHeader::kFloat;
+    }
+    [[nodiscard]] std::uint64_t dataSize() const noexcept;
+    [[nodiscard]] std::uint64_t numFrames() const noexcept;
+
+    // Both overloads walk the chunk list by declared size and leave the
+    // cursor on the first byte of the sample payload.
+    // Both also reject, before any sample is read, a format other than
+    // integer PCM or IEEE float and one the payload cannot be framed by (no
+    // channels, a width that is not whole bytes, a BlockAlign that does not
+    // match).
     void read(std::ifstream &file);
+    void read(bytes::ByteReader &bytes);
     void write(std::ofstream &file) const;
+    // Recomputes every size field; promotes to RF64 when the RIFF size no
+    // longer fits in 32 bits.
     void update(std::uint16_t bitDepth, std::uint32_t sampleRate,
-                std::uint16_t numChannels, std::uint32_t numFrames,
+                std::uint16_t numChannels, std::uint64_t numFrames,
                 bool isFloat);
 };
 } // namespace sk::headers::WAV
@@ -0,0 +1,560 @@
+#include "AsyncIO.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SINEKIT_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+struct Request {
+    std::uint8_t *Buffer;
+    std::size_t Length;
+    std::uint64_t Offset;
+    bool Write;
+    // Bytes transferred, or a negated errno.
+    std::int64_t Result{0};
+    bool Done{false};
+};
+
+// ── Native file handle and blocking positional I/O ───────────────────────
+#ifdef _WIN32
+
+using NativeFile = HANDLE;
+const NativeFile kInvalidFile = INVALID_HANDLE_VALUE;
+
+NativeFile openNative(const std::filesystem::path &path,
+                      sk::io::AsyncFile::Mode mode) {
+    const bool write = mode == sk::io::AsyncFile::Mode::Write;
+    return CreateFileW(path.c_str(), write ? GENERIC_WRITE : GENERIC_READ,
+                       FILE_SHARE_READ, nullptr,
+                       write ? OPEN_ALWAYS : OPEN_EXISTING,
+                       FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+}
+
+void closeNative(NativeFile file) noexcept { CloseHandle(file); }
+
+std::int64_t transfer(NativeFile file, std::uint8_t *buffer,
+                      std::size_t length, std::uint64_t offset, bool write) {
+    OVERLAPPED at{};
+    at.Offset = static_cast<DWORD>(offset);
+    at.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    const auto n = static_cast<DWORD>(
+        std::min<std::size_t>(length, std::size_t{1} << 30));
+    DWORD done = 0;
+    const BOOL ok = write ? WriteFile(file, buffer, n, &done, &at)
+                          : ReadFile(file, buffer, n, &done, &at);
+    if (!ok)
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -EIO;
+    return done;
+}
+
+#else
+
+using NativeFile = int;
+const NativeFile kInvalidFile = -1;
+
+NativeFile openNative(const std::filesystem::path &path,
+                      sk::io::AsyncFile::Mode mode) {
+    if (mode == sk::io::AsyncFile::Mode::Write)
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (fd >= 0)
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    return fd;
+}
+
+void closeNative(NativeFile file) noexcept { ::close(file); }
+
+std::int64_t transfer(NativeFile file, std::uint8_t *buffer,
+                      std::size_t length, std::uint64_t offset, bool write) {
+    while (true) {
+        const ssize_t n =
+            write ? ::pwrite(file, buffer, length, static_cast<off_t>(offset))
+                  : ::pread(file, buffer, length, static_cast<off_t>(offset));
+        if (n >= 0)
+            return n;
+        if (errno != EINTR)
+            return -errno;
+    }
+}
+
+#endif
+
+} // namespace
+
+// ─── Engines ──────────────────────────────────────────────────────────────
+struct sk::io::AsyncFile::Impl {
+    // The handle stays owned by AsyncFile, which closes it after the
+    // engine is gone.
+    explicit Impl(NativeFile file) : File(file) {}
+    virtual ~Impl() = default;
+
+    virtual void submit(Request &request) = 0;
+    // Return once request.Done is set.
+    virtual void wait(Request &request) = 0;
+
+    NativeFile File;
+    // A deque never moves its elements on push_back/pop_front, so the
+    // engines can keep pointers to in‑flight requests.
+    std::deque<Request> Pending;
+};
+
+namespace {
+
+// One worker performs the requests in order with blocking pread/pwrite.
+// That is enough to overlap I/O with decoding on any platform.
+class ThreadEngine final : public sk::io::AsyncFile::Impl {
+  public:
+    explicit ThreadEngine(NativeFile file)
+        : Impl(file), Worker_([this] { run(); }) {}
+
+    ~ThreadEngine() override {
+        {
+            std::lock_guard lock(Mutex_);
+            Stop_ = true;
+        }
+        Wake_.notify_all();
+        Worker_.join();
+    }
+
+    void submit(Request &request) override {
+        {
+            std::lock_guard lock(Mutex_);
+            Queue_.push_back(&request);
+        }
+        Wake_.notify_all();
+    }
+
+    void wait(Request &request) override {
+        std::unique_lock lock(Mutex_);
+        Done_.wait(lock, [&] { return request.Done; });
+    }
+
+  private:
+    void run() {
+        std::unique_lock lock(Mutex_);
+        while (true) {
+            Wake_.wait(lock, [&] { return Stop_ || !Queue_.empty(); });
+            if (Queue_.empty())
+                return;
+            Request *request = Queue_.front();
+            Queue_.pop_front();
+            lock.unlock();
+            const std::int64_t result =
+                transfer(File, request->Buffer, request->Length,
+                         request->Offset, request->Write);
+            lock.lock();
+            request->Result = result;
+            request->Done = true;
+            Done_.notify_all();
+        }
+    }
+
+    std::mutex Mutex_;
+    std::condition_variable Wake_;
+    std::condition_variable Done_;
+    std::deque<Request *> Queue_;
+    bool Stop_{false};
+    std::thread Worker_;
+};
+
+#ifdef SINEKIT_HAVE_IO_URING
+
+int uringSetup(unsigned entries, io_uring_params *params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uringEnter(int ring, unsigned submit, unsigned minComplete,
+               unsigned flags) {
+    while (true) {
+        const int n = static_cast<int>(::syscall(
+            __NR_io_uring_enter, ring, submit, minComplete, flags, nullptr, 0));
+        if (n >= 0 || errno != EINTR)
+            return n;
+    }
+}
+
+// Talks to the kernel directly through the io_uring syscalls and the two
+// shared rings, so no liburing dependency is needed.
+class UringEngine final : public sk::io::AsyncFile::Impl {
+  public:
+    static constexpr unsigned kEntries = 16;
+
+    explicit UringEngine(NativeFile file) : Impl(file) {
+        io_uring_params params{};
+        Ring_ = uringSetup(kEntries, &params);
+        if (Ring_ < 0)
+            throw std::runtime_error("io_uring_setup failed");
+        // IORING_OP_READ/WRITE arrived in 5.6 together with this flag.
+        if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+            ::close(Ring_);
+            throw std::runtime_error("io_uring lacks IORING_OP_READ");
+        }
+
+        SqBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        CqBytes_ =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single)
+            SqBytes_ = CqBytes_ = std::max(SqBytes_, CqBytes_);
+
+        SqRing_ = map(SqBytes_, IORING_OFF_SQ_RING);
+        CqRing_ = single ? SqRing_ : map(CqBytes_, IORING_OFF_CQ_RING);
+        SqesBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        Sqes_ = static_cast<io_uring_sqe *>(map(SqesBytes_, IORING_OFF_SQES));
+        if (SqRing_ == nullptr || CqRing_ == nullptr || Sqes_ == nullptr) {
+            release();
+            throw std::runtime_error("io_uring ring mmap failed");
+        }
+
+        auto *sq = static_cast<std::uint8_t *>(SqRing_);
+        auto *cq = static_cast<std::uint8_t *>(CqRing_);
+        SqHead_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        SqTail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        SqMask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        SqArray_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        CqHead_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        CqTail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        CqMask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        Cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        SqEntries_ = params.sq_entries;
+    }
+
+    ~UringEngine() override { release(); }
+
+    void submit(Request &request) override {
+        const unsigned tail = *SqTail_;
+        if (tail - std::atomic_ref(*SqHead_).load(std::memory_order_acquire) >=
+            SqEntries_)
+            throw std::runtime_error("io_uring submission queue full");
+
+        const unsigned index = tail & SqMask_;
+        io_uring_sqe &sqe = Sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = request.Write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe.fd = File;
+        sqe.addr = reinterpret_cast<std::uint64_t>(request.Buffer);
+        // Longer requests come back short and are finished by waitOldest.
+        sqe.len = static_cast<std::uint32_t>(
+            std::min<std::size_t>(request.Length, std::size_t{1} << 30));
+        sqe.off = request.Offset;
+        sqe.user_data = reinterpret_cast<std::uint64_t>(&request);
+        SqArray_[index] = index;
+        std::atomic_ref(*SqTail_).store(tail + 1, std::memory_order_release);
+
+        if (uringEnter(Ring_, 1, 0, 0) < 0)
+            throw std::runtime_error(std::string("io_uring_enter: ") +
+                                     std::strerror(errno));
+    }
+
+    void wait(Request &request) override {
+        while (true) {
+            reap();
+            if (request.Done)
+                return;
+            if (uringEnter(Ring_, 0, 1, IORING_ENTER_GETEVENTS) < 0)
+                throw std::runtime_error(std::string("io_uring_enter: ") +
+                                         std::strerror(errno));
+        }
+    }
+
+  private:
+    void *map(std::size_t bytes, off_t offset) const {
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, Ring_, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    void reap() {
+        unsigned head = *CqHead_;
+        const unsigned tail =
+            std::atomic_ref(*CqTail_).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const io_uring_cqe &cqe = Cqes_[head & CqMask_];
+            auto *request = reinterpret_cast<Request *>(cqe.user_data);
+            request->Result = cqe.res;
+            request->Done = true;
+        }
+        std::atomic_ref(*CqHead_).store(head, std::memory_order_release);
+    }
+
+    void release() noexcept {
+        if (Sqes_ != nullptr)
+            ::munmap(Sqes_, SqesBytes_);
+        if (CqRing_ != nullptr && CqRing_ != SqRing_)
+            ::munmap(CqRing_, CqBytes_);
+        if (SqRing_ != nullptr)
+            ::munmap(SqRing_, SqBytes_);
+        if (Ring_ >= 0)
+            ::close(Ring_);
+    }
+
+    int Ring_{-1};
+    void *SqRing_{nullptr};
+    void *CqRing_{nullptr};
+    io_uring_sqe *Sqes_{nullptr};
+    std::size_t SqBytes_{0};
+    std::size_t CqBytes_{0};
+    std::size_t SqesBytes_{0};
+    unsigned *SqHead_{nullptr};
+    unsigned *SqTail_{nullptr};
+    unsigned *SqArray_{nullptr};
+    unsigned SqMask_{0};
+    unsigned SqEntries_{0};
+    unsigned *CqHead_{nullptr};
+    unsigned *CqTail_{nullptr};
+    unsigned CqMask_{0};
+    io_uring_cqe *Cqes_{nullptr};
+};
+
+#endif
+
+} // namespace
+
+bool sk::io::ioUringAvailable() noexcept {
+#ifdef SINEKIT_HAVE_IO_URING
+    // Probed once: seccomp policies and old kernels both show up here.
+    static const bool available = [] {
+        io_uring_params params{};
+        const int ring = uringSetup(2, &params);
+        if (ring < 0)
+            return false;
+        ::close(ring);
+        return (params.features & IORING_FEAT_RW_CUR_POS) != 0;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+// ─── AsyncFile ────────────────────────────────────────────────────────────
+sk::io::AsyncFile::AsyncFile(const std::filesystem::path &path, Mode mode,
+                             IOBackend backend) {
+    const NativeFile file = openNative(path, mode);
+    if (file == kInvalidFile)
+        throw std::runtime_error(
+            (mode == Mode::Write ? "create " : "open ") + path.string());
+
+    if (backend == IOBackend::Auto)
+        backend = ioUringAvailable() ? IOBackend::IOUring : IOBackend::Thread;
+    try {
+        switch (backend) {
+        case IOBackend::IOUring:
+#ifdef SINEKIT_HAVE_IO_URING
+            Impl_ = std::make_unique<UringEngine>(file);
+            break;
+#else
+            throw std::runtime_error("io_uring is not available");
+#endif
+        default:
+            Impl_ = std::make_unique<ThreadEngine>(file);
+            break;
+        }
+    } catch (...) {
+        closeNative(file);
+        throw;
+    }
+    Backend_ = backend;
+}
+
+sk::io::AsyncFile::~AsyncFile() {
+    // The kernel (or the worker) may still be touching the buffers.
+    while (!Impl_->Pending.empty()) {
+        try {
+            Impl_->wait(Impl_->Pending.front());
+        } catch (...) {
+            // Nothing sensible to do; the ring is torn down next.
+        }
+        Impl_->Pending.pop_front();
+    }
+    const NativeFile file = Impl_->File;
+    Impl_.reset();
+    closeNative(file);
+}
+
+std::size_t sk::io::AsyncFile::pending() const noexcept {
+    return Impl_->Pending.size();
+}
+
+void sk::io::AsyncFile::submitRead(void *buffer, std::size_t length,
+                                   std::uint64_t offset) {
+    Request &request = Impl_->Pending.emplace_back(
+        Request{static_cast<std::uint8_t *>(buffer), length, offset, false});
+    try {
+        Impl_->submit(request);
+    } catch (...) {
+        Impl_->Pending.pop_back();
+        throw;
+    }
+}
+
+void sk::io::AsyncFile::submitWrite(const void *buffer, std::size_t length,
+                                    std::uint64_t offset) {
+    // The buffer is only ever read from; Request is shared with reads.
+    Request &request = Impl_->Pending.emplace_back(
+        Request{static_cast<std::uint8_t *>(const_cast<void *>(buffer)),
+                length, offset, true});
+    try {
+        Impl_->submit(request);
+    } catch (...) {
+        Impl_->Pending.pop_back();
+        throw;
+    }
+}
+
+std::size_t sk::io::AsyncFile::waitOldest() {
+    if (Impl_->Pending.empty())
+        throw std::runtime_error("no I/O request pending");
+    Request request = [&] {
+        Request &oldest = Impl_->Pending.front();
+        Impl_->wait(oldest);
+        Request copy = oldest;
+        Impl_->Pending.pop_front();
+        return copy;
+    }();
+
+    const std::string what = request.Write ? "write failed: " : "read failed: ";
+    if (request.Result < 0)
+        throw std::runtime_error(
+            what + std::strerror(static_cast<int>(-request.Result)));
+
+    auto done = static_cast<std::size_t>(request.Result);
+    while (done < request.Length) {
+        const std::int64_t n =
+            transfer(Impl_->File, request.Buffer + done,
+                     request.Length - done, request.Offset + done,
+                     request.Write);
+        if (n < 0)
+            throw std::runtime_error(what +
+                                     std::strerror(static_cast<int>(-n)));
+        if (n == 0) {
+            if (request.Write)
+                throw std::runtime_error("write made no progress");
+            break;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    return done;
+}
+
+// ─── BlockReader ──────────────────────────────────────────────────────────
+namespace {
+
+// The largest multiple of granule within blockBytes, and at least one.
+std::size_t wholeGranules(std::size_t granule, std::size_t blockBytes) {
+    if (granule == 0)
+        throw std::runtime_error("block granule is zero");
+    return std::max(granule, blockBytes / granule * granule);
+}
+
+} // namespace
+
+sk::io::BlockReader::BlockReader(const std::filesystem::path &path,
+                                 std::uint64_t offset, std::uint64_t length,
+                                 std::size_t granule, std::size_t blockBytes,
+                                 std::size_t depth, IOBackend backend)
+    : File_(path, AsyncFile::Mode::Read, backend), Next_(offset),
+      End_(offset + length),
+      BlockBytes_(wholeGranules(granule, blockBytes)) {
+    depth = std::max<std::size_t>(depth, 1);
+    const auto blocks = static_cast<std::size_t>(std::min<std::uint64_t>(
+        depth, (length + BlockBytes_ - 1) / BlockBytes_));
+    Blocks_.reserve(blocks);
+    for (std::size_t i = 0; i < blocks; ++i)
+        Blocks_.emplace_back(BlockBytes_);
+    Lengths_.assign(blocks, 0);
+    for (std::size_t i = 0; i < blocks; ++i)
+        issue(i);
+}
+
+void sk::io::BlockReader::issue(std::size_t slot) {
+    if (Next_ >= End_)
+        return;
+    const auto n = static_cast<std::size_t>(
+        std::min<std::uint64_t>(BlockBytes_, End_ - Next_));
+    File_.submitRead(Blocks_[slot].Data.get(), n, Next_);
+    Lengths_[slot] = n;
+    Next_ += n;
+}
+
+std::span<const std::uint8_t> sk::io::BlockReader::next() {
+    // Hand the block the caller just finished with back to the queue; it
+    // becomes the newest request, which keeps slots in submission order.
+    if (Holding_) {
+        issue((Oldest_ + Blocks_.size() - 1) % Blocks_.size());
+        Holding_ = false;
+    }
+    if (File_.pending() == 0)
+        return {};
+
+    const std::size_t slot = Oldest_;
+    if (File_.waitOldest() != Lengths_[slot])
+        throw std::runtime_error("unexpected end of file");
+    Oldest_ = (Oldest_ + 1) % Blocks_.size();
+    Holding_ = true;
+    return {Blocks_[slot].Data.get(), Lengths_[slot]};
+}
+
+// ─── BlockWriter ──────────────────────────────────────────────────────────
+sk::io::BlockWriter::BlockWriter(const std::filesystem::path &path,
+                                 std::uint64_t offset, std::size_t blockBytes,
+                                 std::size_t depth, IOBackend backend)
+    : File_(path, AsyncFile::Mode::Write, backend), Offset_(offset) {
+    depth = std::max<std::size_t>(depth, 1);
+    Blocks_.reserve(depth);
+    for (std::size_t i = 0; i < depth; ++i)
+        Blocks_.emplace_back(blockBytes);
+    Busy_.assign(depth, false);
+}
+
+std::span<std::uint8_t> sk::io::BlockWriter::buffer() {
+    // Writes retire in submission order, so a busy current slot is always
+    // the oldest request in the queue.
+    if (Busy_[Current_]) {
+        File_.waitOldest();
+        Busy_[Current_] = false;
+    }
+    return {Blocks_[Current_].Data.get(), Blocks_[Current_].Size};
+}
+
+void sk::io::BlockWriter::commit(std::size_t bytes) {
+    if (Busy_[Current_] || bytes > Blocks_[Current_].Size)
+        throw std::runtime_error("commit without a free buffer");
+    if (bytes == 0)
+        return;
+    File_.submitWrite(Blocks_[Current_].Data.get(), bytes, Offset_);
+    Busy_[Current_] = true;
+    Offset_ += bytes;
+    Current_ = (Current_ + 1) % Blocks_.size();
+}
+
+void sk::io::BlockWriter::finish() {
+    while (File_.pending() != 0)
+        File_.waitOldest();
+    std::fill(Busy_.begin(), Busy_.end(), false);
+}
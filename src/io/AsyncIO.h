@@ -0,0 +1,147 @@
+#ifndef ASYNCIO_H
+#define ASYNCIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace sk::io {
+
+// Auto picks io_uring where the kernel offers it (Linux 5.6+) and falls
+// back to a worker thread doing positional reads/writes everywhere else.
+enum class IOBackend { Auto, IOUring, Thread };
+
+// Defaults used by loadFile/writeFile: requests large enough for the device
+// to stream, blocks small enough that the codec still finds the one it is
+// working on in L2, and a few of them in flight to keep the queue busy.
+inline constexpr std::size_t kIOBlockBytes = std::size_t{1} << 20;
+inline constexpr std::size_t kIOQueueDepth = 4;
+inline constexpr std::size_t kIOAlignment = 4096;
+
+[[nodiscard]] bool ioUringAvailable() noexcept;
+
+// ── Queue of positional reads/writes against one file ────────────────────
+// Requests complete in any order underneath but are retired strictly in
+// submission order by waitOldest().  Buffers must stay alive until their
+// request has been retired; the destructor drains anything outstanding.
+class AsyncFile {
+  public:
+    enum class Mode { Read, Write };
+
+    // Write mode creates the file if needed but never truncates it, so a
+    // header written by an ofstream beforehand is preserved.
+    AsyncFile(const std::filesystem::path &path, Mode mode,
+              IOBackend backend = IOBackend::Auto);
+    ~AsyncFile();
+
+    AsyncFile(const AsyncFile &) = delete;
+    AsyncFile &operator=(const AsyncFile &) = delete;
+
+    [[nodiscard]] IOBackend backend() const noexcept { return Backend_; }
+    [[nodiscard]] std::size_t pending() const noexcept;
+
+    void submitRead(void *buffer, std::size_t length, std::uint64_t offset);
+    void submitWrite(const void *buffer, std::size_t length,
+                     std::uint64_t offset);
+
+    // Block until the oldest request completes and return the number of
+    // bytes transferred.  Short transfers are finished synchronously, so a
+    // read only comes back short at end of file.  Throws on I/O errors.
+    std::size_t waitOldest();
+
+    // Backend engine; the implementations live in AsyncIO.cpp.
+    struct Impl;
+
+  private:
+    std::unique_ptr<Impl> Impl_;
+    IOBackend Backend_;
+};
+
+// 4 KiB aligned heap block, suitable for any backend's DMA constraints.
+struct AlignedBlock {
+    struct Free {
+        void operator()(std::uint8_t *p) const noexcept {
+            ::operator delete[](p, std::align_val_t{kIOAlignment});
+        }
+    };
+    explicit AlignedBlock(std::size_t bytes)
+        : Data(static_cast<std::uint8_t *>(
+              ::operator new[](bytes, std::align_val_t{kIOAlignment}))),
+          Size(bytes) {}
+
+    std::unique_ptr<std::uint8_t[], Free> Data;
+    std::size_t Size;
+};
+
+// ── Read‑ahead over a byte range ─────────────────────────────────────────
+// Keeps `depth` blocks in flight so the next one is already arriving while
+// the caller decodes the current one.  Blocks are whole multiples of
+// `granule` bytes (one frame), so no frame ever straddles two blocks; a
+// zero granule throws.
+class BlockReader {
+  public:
+    BlockReader(const std::filesystem::path &path, std::uint64_t offset,
+                std::uint64_t length, std::size_t granule,
+                std::size_t blockBytes = kIOBlockBytes,
+                std::size_t depth = kIOQueueDepth,
+                IOBackend backend = IOBackend::Auto);
+
+    // The next block of the range, or an empty span once it is exhausted.
+    // The span stays valid until the following call.
+    std::span<const std::uint8_t> next();
+
+    [[nodiscard]] IOBackend backend() const noexcept {
+        return File_.backend();
+    }
+
+  private:
+    void issue(std::size_t slot);
+
+    std::vector<AlignedBlock> Blocks_;
+    std::vector<std::size_t> Lengths_;
+    // Declared after the blocks so it is destroyed, and drained, first.
+    AsyncFile File_;
+    std::uint64_t Next_;
+    std::uint64_t End_;
+    std::size_t BlockBytes_;
+    std::size_t Oldest_{0};
+    std::size_t Issued_{0};
+    bool Holding_{false};
+};
+
+// ── Write‑behind from a byte offset onwards ──────────────────────────────
+// The caller fills buffer(), hands it over with commit() and immediately
+// gets the next free block while the previous ones are being written.
+class BlockWriter {
+  public:
+    BlockWriter(const std::filesystem::path &path, std::uint64_t offset,
+                std::size_t blockBytes = kIOBlockBytes,
+                std::size_t depth = kIOQueueDepth,
+                IOBackend backend = IOBackend::Auto);
+
+    // A free block of blockBytes bytes; waits for its previous write.
+    std::span<std::uint8_t> buffer();
+    // Queue the first `bytes` bytes of buffer() for writing.
+    void commit(std::size_t bytes);
+    // Wait for every queued write; only this reports write errors.
+    void finish();
+
+    [[nodiscard]] IOBackend backend() const noexcept {
+        return File_.backend();
+    }
+
+  private:
+    std::vector<AlignedBlock> Blocks_;
+    std::vector<bool> Busy_;
+    AsyncFile File_;
+    std::uint64_t Offset_;
+    std::size_t Current_{0};
+};
+
+} // namespace sk::io
+
+#endif // ASYNCIO_H
@@ -0,0 +1,361 @@
+#include "BatchConverter.h"
+
+#include "../SineKit.h"
+#include "../dsp/FilterCache.h"
+#include "../lib/Parallel.h"
+#include "AsyncIO.h"
+#include "Probe.h"
+#include "Transcode.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Counting budget that admits requests strictly in arrival order.  A
+// request larger than the whole budget is admitted once nothing else is
+// running.
+class MemoryBudget {
+  public:
+    explicit MemoryBudget(std::size_t limit) : Limit_(limit) {}
+
+    void acquire(std::size_t bytes) {
+        std::unique_lock lock(Mutex_);
+        const std::uint64_t ticket = NextTicket_++;
+        Changed_.wait(lock, [&] {
+            return ticket == Serving_ &&
+                   (Used_ == 0 || Used_ + bytes <= Limit_);
+        });
+        Used_ += bytes;
+        Peak_ = std::max(Peak_, Used_);
+        ++Serving_;
+        Changed_.notify_all();
+    }
+
+    void release(std::size_t bytes) {
+        {
+            std::lock_guard lock(Mutex_);
+            Used_ -= bytes;
+        }
+        Changed_.notify_all();
+    }
+
+    [[nodiscard]] std::size_t peak() const {
+        std::lock_guard lock(Mutex_);
+        return Peak_;
+    }
+
+  private:
+    mutable std::mutex Mutex_;
+    std::condition_variable Changed_;
+    std::size_t Limit_;
+    std::size_t Used_{0};
+    std::size_t Peak_{0};
+    std::uint64_t NextTicket_{0};
+    std::uint64_t Serving_{0};
+};
+
+// Bytes one sample occupies in SineKit's typed buffers.
+std::size_t memoryWidth(sk::BitType depth) {
+    switch (depth) {
+    case sk::BitType::I8:
+        return 1;
+    case sk::BitType::I16:
+        return 2;
+    case sk::BitType::I24:
+    case sk::BitType::I32:
+    case sk::BitType::F32:
+        return 4;
+    case sk::BitType::F64:
+        return 8;
+    default:
+        throw std::runtime_error("unsupported bit depth");
+    }
+}
+
+// Orders depths by precision; float wins a tie because interpolating in
+// it does not round.
+int precision(sk::BitType depth) {
+    switch (depth) {
+    case sk::BitType::I8:
+        return 0;
+    case sk::BitType::I16:
+        return 1;
+    case sk::BitType::I24:
+        return 2;
+    case sk::BitType::F32:
+        return 3;
+    case sk::BitType::I32:
+        return 4;
+    default:
+        return 5;
+    }
+}
+
+// Why a job to or from DSD (D1) cannot run, or nullptr; checked before it
+// queues for budget.  The rates are those toPCM and toDSD accept.
+const char *dsdProblem(const sk::ProbeInfo &info, sk::BitType depth,
+                       sk::SampleRate rate) {
+    const auto in = static_cast<std::uint32_t>(info.Rate);
+    const auto out = static_cast<std::uint32_t>(rate);
+    if (info.Depth == sk::BitType::D1 && depth == sk::BitType::D1)
+        return out == in ? nullptr : "DSD cannot be resampled as DSD";
+    if (info.Depth == sk::BitType::D1)
+        return out != 0 && in % out == 0 && in / out >= 8 &&
+                       std::has_single_bit(in / out)
+                   ? nullptr
+                   : "DSD to PCM needs the DSD rate over 8 × a power of two";
+    return in != 0 && out % in == 0 && out / in % 8 == 0
+               ? nullptr
+               : "PCM to DSD needs a multiple of 8 × the PCM rate";
+}
+
+// Peak footprint of a job to or from DSD, which runs in memory: DSD takes
+// an eighth of a byte a sample, and the PCM side passes through F32.
+std::uint64_t dsdFootprint(const sk::ProbeInfo &info, sk::BitType depth,
+                           sk::SampleRate rate) {
+    const std::uint64_t ch = info.NumChannels;
+    const auto in = static_cast<std::uint32_t>(info.Rate);
+    const auto out = static_cast<std::uint32_t>(rate);
+    if (info.Depth == sk::BitType::D1 && depth == sk::BitType::D1)
+        return ch * ((info.NumFrames + 7) / 8);
+    if (info.Depth == sk::BitType::D1) {
+        // The DSD, its F32 decimation and, for another depth, the copy
+        // toBitDepth makes of that.
+        const std::uint64_t frames = info.NumFrames / (in / out);
+        const std::uint64_t to =
+            depth == sk::BitType::F32 ? 0 : memoryWidth(depth);
+        return ch * ((info.NumFrames + 7) / 8 + frames * (4 + to));
+    }
+    // The PCM, the F32 copy integer PCM is modulated from, and the DSD.
+    const std::uint64_t from = memoryWidth(info.Depth);
+    const std::uint64_t f32 = info.IsFloat ? 0 : 4;
+    return ch * (info.NumFrames * (from + f32) +
+                 info.NumFrames * (out / in) / 8);
+}
+
+// Rough upper bound on what a job holds at its peak.
+std::size_t estimate(sk::io::BatchMode mode, const sk::ProbeInfo &info,
+                     sk::BitType depth, sk::SampleRate rate,
+                     std::size_t blockFrames) {
+    // Always in memory, plus the I/O queues.
+    if (info.Depth == sk::BitType::D1 || depth == sk::BitType::D1)
+        return static_cast<std::size_t>(
+            dsdFootprint(info, depth, rate) +
+            2 * sk::io::kIOQueueDepth * sk::io::kIOBlockBytes);
+    const std::uint64_t ch = info.NumChannels;
+    const std::uint64_t from = memoryWidth(info.Depth);
+    const std::uint64_t to = memoryWidth(depth);
+    std::uint64_t bytes = 0;
+    switch (mode) {
+    case sk::io::BatchMode::Passthrough:
+        // Reader and writer each keep their queue of I/O blocks.
+        bytes = 2 * sk::io::kIOQueueDepth * sk::io::kIOBlockBytes;
+        break;
+    case sk::io::BatchMode::Fused:
+        // The I/O queues plus one step of decoded and converted samples.
+        bytes = 2 * sk::io::kIOQueueDepth * sk::io::kIOBlockBytes +
+                sk::io::kFusedStepBytes;
+        break;
+    case sk::io::BatchMode::Stream:
+        // Raw and decoded input block, converted and encoded output block.
+        bytes = blockFrames * ch * (2 * from + 2 * to);
+        break;
+    case sk::io::BatchMode::InMemory: {
+        // Source and target buffers coexist during toBitDepth; resampling
+        // then holds the buffer and its resampled copy, plus each channel
+        // in flight in double on either side of the filter.
+        const std::uint64_t src = std::max<std::uint32_t>(
+            1, static_cast<std::uint32_t>(info.Rate));
+        const std::uint64_t scale =
+            (static_cast<std::uint32_t>(rate) + src - 1) / src;
+        const std::uint64_t wide = std::max(from, to);
+        bytes = info.NumFrames * ch *
+                    (std::max(from + to, wide * (1 + scale)) +
+                     sizeof(double) * (1 + scale)) +
+                2 * sk::io::kIOQueueDepth * sk::io::kIOBlockBytes;
+        break;
+    }
+    }
+    return static_cast<std::size_t>(bytes);
+}
+
+void runJob(const sk::io::BatchJob &job, sk::io::BatchJobReport &report,
+            MemoryBudget &budget, const sk::io::BatchOptions &options) {
+    const Clock::time_point queued = Clock::now();
+    const sk::ProbeInfo info = sk::probe(job.Input);
+    const sk::BitType depth =
+        job.Depth == sk::BitType::Undefined ? info.Depth : job.Depth;
+    const sk::SampleRate rate =
+        job.Rate == sk::SampleRate::Undefined ? info.Rate : job.Rate;
+
+    const bool dsd =
+        info.Depth == sk::BitType::D1 || depth == sk::BitType::D1;
+    if (dsd) {
+        if (const char *problem = dsdProblem(info, depth, rate))
+            throw std::runtime_error(problem);
+    }
+
+    if (dsd || rate != info.Rate)
+        report.Mode = sk::io::BatchMode::InMemory;
+    else if (depth != info.Depth)
+        report.Mode = options.Fused ? sk::io::BatchMode::Fused
+                                    : sk::io::BatchMode::Stream;
+    else
+        report.Mode = sk::io::BatchMode::Passthrough;
+    report.Frames = info.NumFrames;
+    report.InputBytes = std::filesystem::file_size(job.Input);
+    report.Reserved = estimate(report.Mode, info, depth, rate,
+                               options.StreamBlockFrames);
+
+    budget.acquire(report.Reserved);
+    struct Release {
+        MemoryBudget &Budget;
+        std::size_t Bytes;
+        ~Release() { Budget.release(Bytes); }
+    } release{budget, report.Reserved};
+    report.QueuedSeconds = secondsSince(queued);
+
+    const Clock::time_point start = Clock::now();
+    switch (report.Mode) {
+    case sk::io::BatchMode::Passthrough:
+        sk::io::transcodeFile(job.Input, job.Output);
+        break;
+    case sk::io::BatchMode::Fused:
+        sk::io::convertFileFused(job.Input, job.Output, depth, job.Dither,
+                                 job.Shaping);
+        break;
+    case sk::io::BatchMode::Stream:
+        sk::io::convertFile(job.Input, job.Output, depth,
+                            options.StreamBlockFrames, job.Dither,
+                            job.Shaping);
+        break;
+    case sk::io::BatchMode::InMemory: {
+        sk::SineKit kit;
+        kit.loadFile(job.Input);
+        if (dsd) {
+            // DSD → DSD only changes the container.
+            if (info.Depth != sk::BitType::D1) {
+                kit.toDSD(rate);
+            } else if (depth != sk::BitType::D1) {
+                kit.toPCM(rate, sk::BitType::F32);
+                if (depth != sk::BitType::F32)
+                    kit.toBitDepth(depth, job.Dither, job.Shaping);
+            }
+        } else if (precision(depth) > precision(info.Depth)) {
+            // Resample in whichever of the two depths is the more precise.
+            kit.toBitDepth(depth, job.Dither, job.Shaping);
+            kit.toSampleRate(rate, job.Quality);
+        } else {
+            kit.toSampleRate(rate, job.Quality);
+            kit.toBitDepth(depth, job.Dither, job.Shaping);
+        }
+        kit.writeFile(job.Output);
+        break;
+    }
+    }
+    report.Seconds = secondsSince(start);
+    report.OutputBytes = std::filesystem::file_size(job.Output);
+}
+
+} // namespace
+
+sk::io::BatchConverter::BatchConverter(BatchOptions options)
+    : Options_(options) {
+    if (Options_.Threads == 0)
+        Options_.Threads = std::max(1u, std::thread::hardware_concurrency());
+    Options_.StreamBlockFrames = std::max<std::size_t>(
+        Options_.StreamBlockFrames, 1);
+}
+
+void sk::io::BatchConverter::add(BatchJob job) {
+    Jobs_.push_back(std::move(job));
+}
+
+sk::io::BatchReport sk::io::BatchConverter::run() {
+    const std::vector<BatchJob> jobs = std::move(Jobs_);
+    Jobs_.clear();
+
+    BatchReport report;
+    report.Jobs.resize(jobs.size());
+    MemoryBudget budget(Options_.MemoryBudget);
+    const Clock::time_point start = Clock::now();
+
+    sk::dsp::FilterCache &filters = sk::dsp::FilterCache::instance();
+    const bool cached = !Options_.FilterCache.empty();
+    // The cache only saves work: a file that cannot be used is reported,
+    // and the jobs run (and the cache is rewritten) without it.
+    auto cacheFailed = [&](const char *what, const std::exception &e) {
+        if (!report.FilterCacheError.empty())
+            report.FilterCacheError += "; ";
+        report.FilterCacheError += std::string(what) + ": " + e.what();
+    };
+    if (cached) {
+        try {
+            if (std::filesystem::exists(Options_.FilterCache))
+                filters.load(Options_.FilterCache);
+        } catch (const std::exception &e) {
+            cacheFailed("load", e);
+        }
+    }
+
+    // The thread budget is split between the workers, so a job's own
+    // per‑channel pools (toSampleRate, toPCM, ...) keep the batch within
+    // Options_.Threads instead of starting a full pool per worker.
+    const auto threads = static_cast<unsigned>(std::min<std::size_t>(
+        Options_.Threads, std::max<std::size_t>(jobs.size(), 1)));
+    const unsigned share = std::max(1u, Options_.Threads / threads);
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        const sk::parallel::ThreadBudget cpu(share);
+        for (std::size_t i = next++; i < jobs.size(); i = next++) {
+            BatchJobReport &job = report.Jobs[i];
+            job.Input = jobs[i].Input;
+            job.Output = jobs[i].Output;
+            try {
+                runJob(jobs[i], job, budget, Options_);
+            } catch (const std::exception &e) {
+                job.Error = e.what();
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+            pool.emplace_back(worker);
+        worker();
+    }
+    if (cached) {
+        try {
+            filters.save(Options_.FilterCache);
+        } catch (const std::exception &e) {
+            cacheFailed("save", e);
+        }
+    }
+
+    report.Seconds = secondsSince(start);
+    report.PeakReserved = budget.peak();
+    for (const BatchJobReport &job : report.Jobs) {
+        if (!job.ok()) {
+            ++report.Failed;
+            continue;
+        }
+        report.Frames += job.Frames;
+        report.InputBytes += job.InputBytes;
+        report.OutputBytes += job.OutputBytes;
+    }
+    return report;
+}
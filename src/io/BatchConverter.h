@@ -0,0 +1,128 @@
+#ifndef BATCHCONVERTER_H
+#define BATCHCONVERTER_H
+
+#include "../AudioTypes.h"
+#include "StreamConvert.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace sk::io {
+
+// One conversion.  Undefined depth or rate means "keep the input's".  D1
+// on either side makes it a DSD job: DSD → PCM decimates to Rate (the DSD
+// rate over 8 × a power of two), PCM → DSD modulates to Rate (a multiple
+// of 8 × the PCM rate), and DSD → DSD keeps the rate and only changes the
+// container.  Other rates fail before the job runs.
+struct BatchJob {
+    std::filesystem::path Input;
+    std::filesystem::path Output;
+    BitType Depth{BitType::Undefined};
+    SampleRate Rate{SampleRate::Undefined};
+    // Used when the depth narrows to an integer one.
+    DitherAmount Dither{DitherAmount::None};
+    NoiseShaping Shaping{NoiseShaping::None};
+    // Used when the rate changes.
+    ResampleQuality Quality{ResampleQuality::Standard};
+};
+
+// How a job was carried out, cheapest first.
+enum class BatchMode {
+    Passthrough, // container rewrap only (transcodeFile)
+    Fused,       // single‑pass depth conversion (convertFileFused)
+    Stream,      // block‑wise depth conversion (convertFile)
+    InMemory     // whole file through SineKit; resampling and DSD jobs
+};
+
+struct BatchJobReport {
+    std::filesystem::path Input;
+    std::filesystem::path Output;
+    BatchMode Mode{BatchMode::Passthrough};
+    // Empty on success, otherwise what went wrong.
+    std::string Error;
+    std::uint64_t Frames{0};
+    std::uint64_t InputBytes{0};
+    std::uint64_t OutputBytes{0};
+    // Memory reserved against the budget while the job ran.
+    std::size_t Reserved{0};
+    // Time spent waiting for budget, and running.
+    double QueuedSeconds{0};
+    double Seconds{0};
+
+    [[nodiscard]] bool ok() const noexcept { return Error.empty(); }
+    [[nodiscard]] double bytesPerSecond() const noexcept {
+        return Seconds > 0 ? static_cast<double>(InputBytes) / Seconds : 0;
+    }
+    [[nodiscard]] double framesPerSecond() const noexcept {
+        return Seconds > 0 ? static_cast<double>(Frames) / Seconds : 0;
+    }
+};
+
+struct BatchReport {
+    // In the order the jobs were added.
+    std::vector<BatchJobReport> Jobs;
+    std::size_t Failed{0};
+    std::uint64_t Frames{0};
+    std::uint64_t InputBytes{0};
+    std::uint64_t OutputBytes{0};
+    // Highest total reservation seen at any one time.
+    std::size_t PeakReserved{0};
+    // Wall‑clock time for the whole batch.
+    double Seconds{0};
+    // Empty unless loading or saving BatchOptions::FilterCache failed;
+    // the jobs run and report either way.
+    std::string FilterCacheError;
+
+    [[nodiscard]] double bytesPerSecond() const noexcept {
+        return Seconds > 0 ? static_cast<double>(InputBytes) / Seconds : 0;
+    }
+    [[nodiscard]] double framesPerSecond() const noexcept {
+        return Seconds > 0 ? static_cast<double>(Frames) / Seconds : 0;
+    }
+};
+
+struct BatchOptions {
+    // Threads for the whole batch, including those a job's conversion
+    // runs channels on: they are split evenly between the job workers.
+    // 0 = one per hardware thread.
+    unsigned Threads{0};
+    // Upper bound on the memory all running jobs may reserve together.  A
+    // job whose estimate alone exceeds it runs by itself.
+    std::size_t MemoryBudget{std::size_t{2} << 30};
+    // Depth‑only jobs run fused unless this is cleared; StreamBlockFrames
+    // applies to the block‑wise path.
+    bool Fused{true};
+    std::size_t StreamBlockFrames{kDefaultStreamBlockFrames};
+    // Saved resampling filters (dsp::FilterCache) to load before the jobs
+    // and to save back after them; empty = none.  A missing file is not an
+    // error, and a file that fails to load or save only sets
+    // BatchReport::FilterCacheError.
+    std::filesystem::path FilterCache;
+};
+
+// ── Many conversions on a fixed thread pool under a memory budget ────────
+// Each job is probed first; its footprint is estimated from the header and
+// the cheapest mode that satisfies it.  Jobs are admitted in order as
+// budget frees up, so a large job is never starved by small ones queued
+// behind it.  A failing job is recorded in its report and does not stop
+// the batch.
+class BatchConverter {
+  public:
+    explicit BatchConverter(BatchOptions options = {});
+
+    void add(BatchJob job);
+    [[nodiscard]] std::size_t size() const noexcept { return Jobs_.size(); }
+
+    // Run every job added so far and clear the queue.
+    BatchReport run();
+
+  private:
+    BatchOptions Options_;
+    std::vector<BatchJob> Jobs_;
+};
+
+} // namespace sk::io
+
+#endif // BATCHCONVERTER_H
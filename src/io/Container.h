@@ -0,0 +1,33 @@
+#ifndef CONTAINER_H
+#define CONTAINER_H
+
+#include "../lib/EndianHelpers.h"
+#include <filesystem>
+#include <stdexcept>
+
+namespace sk::io {
+
+enum class Container { WAV, AIFF, DSF, DSDIFF };
+
+// Containers are picked by file extension, the same way SineKit does it.
+[[nodiscard]] inline Container containerFor(const std::filesystem::path &path) {
+    const auto ext = path.extension();
+    if (ext == ".wav")
+        return Container::WAV;
+    if (ext == ".aiff")
+        return Container::AIFF;
+    if (ext == ".dsf")
+        return Container::DSF;
+    if (ext == ".dff")
+        return Container::DSDIFF;
+    throw std::runtime_error("unsupported container " + ext.string());
+}
+
+[[nodiscard]] constexpr endian::Endian endianFor(Container container) noexcept {
+    return container == Container::AIFF ? endian::Endian::Big
+                                        : endian::Endian::Little;
+}
+
+} // namespace sk::io
+
+#endif // CONTAINER_H
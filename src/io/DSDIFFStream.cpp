@@ -0,0 +1,154 @@
+#include "DSDIFFStream.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// ─── DSDIFFReader ─────────────────────────────────────────────────────────
+sk::io::DSDIFFReader::DSDIFFReader(const std::filesystem::path &path) {
+    std::uint64_t payload;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("open " + path.string());
+        Header_.read(file);
+        payload = static_cast<std::uint64_t>(file.tellg());
+    }
+    const std::uint64_t bytes = numSamples() / 8 * numChannels();
+    if (payload + bytes > std::filesystem::file_size(path))
+        throw std::runtime_error("DSD payload short");
+    Reader_.emplace(path, payload, bytes, numChannels());
+}
+
+std::size_t sk::io::DSDIFFReader::decode(std::span<const std::uint8_t> frames,
+                                         AudioBuffer<std::uint8_t> &out,
+                                         std::size_t at) {
+    const std::size_t ch = numChannels();
+    const std::size_t n = frames.size() / ch;
+    if (ch == 2) {
+        std::uint8_t *left = out.channel(0).data() + at;
+        std::uint8_t *right = out.channel(1).data() + at;
+        for (std::size_t i = 0; i < n; ++i) {
+            left[i] = frames[2 * i];
+            right[i] = frames[2 * i + 1];
+        }
+    } else {
+        for (std::size_t c = 0; c < ch; ++c) {
+            std::uint8_t *dst = out.channel(c).data() + at;
+            const std::uint8_t *src = frames.data() + c;
+            for (std::size_t i = 0; i < n; ++i)
+                dst[i] = src[i * ch];
+        }
+    }
+    Position_ += n * 8;
+    return n * 8;
+}
+
+std::size_t sk::io::DSDIFFReader::read(AudioBuffer<std::uint8_t> &block) {
+    const auto frames = Reader_->next();
+    if (frames.empty())
+        return 0;
+    const std::size_t bytes = frames.size() / numChannels();
+    if (block.numChannels() != numChannels() || block.numFrames() != bytes)
+        block.resizeForOverwrite(numChannels(), bytes);
+    return decode(frames, block, 0);
+}
+
+void sk::io::DSDIFFReader::readAll(AudioBuffer<std::uint8_t> &out) {
+    const std::uint64_t left = numSamples() - Position_;
+    out.resizeForOverwrite(numChannels(), static_cast<std::size_t>(left / 8));
+    std::size_t at = 0;
+    while (Position_ < numSamples()) {
+        const auto frames = Reader_->next();
+        if (frames.empty())
+            throw std::runtime_error("DSD payload short");
+        at += decode(frames, out, at) / 8;
+    }
+}
+
+// ─── DSDIFFWriter ─────────────────────────────────────────────────────────
+sk::io::DSDIFFWriter::DSDIFFWriter(const std::filesystem::path &path,
+                                   SampleRate sampleRate,
+                                   std::uint16_t numChannels)
+    : File_(path, std::ios::binary) {
+    if (!File_)
+        throw std::runtime_error("create " + path.string());
+    // The header's length depends only on the channel count, so it can be
+    // rewritten in place once the data size is known.
+    Header_.update(static_cast<std::uint32_t>(sampleRate), numChannels, 0);
+    Header_.write(File_);
+    File_.flush();
+    if (!File_)
+        throw std::runtime_error("header write failed " + path.string());
+
+    // Whole frames per I/O block, so a frame never straddles two.
+    const std::size_t frame = numChannels;
+    Writer_.emplace(path, static_cast<std::uint64_t>(File_.tellp()),
+                    std::max(frame, kIOBlockBytes / frame * frame));
+    Out_ = Writer_->buffer();
+}
+
+sk::io::DSDIFFWriter::~DSDIFFWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to observe errors.
+    }
+}
+
+void sk::io::DSDIFFWriter::write(const AudioBuffer<std::uint8_t> &block,
+                                 std::uint64_t samples) {
+    if (Closed_)
+        throw std::runtime_error("write to closed stream");
+    if (SamplesWritten_ % 8 != 0)
+        throw std::runtime_error("DSD samples after a partial byte");
+    const std::size_t ch = Header_.chnl.NumChannels;
+    const auto bytes = static_cast<std::size_t>((samples + 7) / 8);
+    if (block.numChannels() != ch || block.numFrames() < bytes)
+        throw std::runtime_error("block shape does not match stream");
+
+    for (std::size_t pos = 0; pos < bytes;) {
+        if (Used_ + ch > Out_.size()) {
+            Writer_->commit(Used_);
+            Out_ = Writer_->buffer();
+            Used_ = 0;
+        }
+        const std::size_t n =
+            std::min((Out_.size() - Used_) / ch, bytes - pos);
+        std::uint8_t *dst = Out_.data() + Used_;
+        for (std::size_t c = 0; c < ch; ++c) {
+            const std::uint8_t *src = block.channel(c).data() + pos;
+            for (std::size_t i = 0; i < n; ++i)
+                dst[i * ch + c] = src[i];
+        }
+        Used_ += n * ch;
+        pos += n;
+    }
+    SamplesWritten_ += samples;
+}
+
+void sk::io::DSDIFFWriter::close() {
+    if (Closed_)
+        return;
+    Closed_ = true;
+
+    const std::uint16_t ch = Header_.chnl.NumChannels;
+    Header_.update(Header_.fs.SampleRate, ch, SamplesWritten_);
+    // IFF chunks are word aligned; the pad byte is not part of the chunk.
+    if (Header_.data.ChunkSize & 1) {
+        if (Used_ == Out_.size()) {
+            Writer_->commit(Used_);
+            Out_ = Writer_->buffer();
+            Used_ = 0;
+        }
+        Out_[Used_++] = 0;
+    }
+    if (Used_ > 0)
+        Writer_->commit(Used_);
+    Writer_->finish();
+
+    File_.seekp(0);
+    Header_.write(File_);
+    File_.close();
+    if (!File_)
+        throw std::runtime_error("DSDIFF header write failed");
+}
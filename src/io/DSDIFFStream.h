@@ -0,0 +1,94 @@
+#ifndef DSDIFFSTREAM_H
+#define DSDIFFSTREAM_H
+
+#include "../AudioTypes.h"
+#include "../headers/DSDIFFHeaders.h"
+#include "AsyncIO.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+
+namespace sk::io {
+
+// ── Block‑wise reader for DSDIFF ─────────────────────────────────────────
+// DSDIFF interleaves one byte per channel and already keeps the oldest
+// sample in the most significant bit, so reading is a plain deinterleave of
+// each I/O block as it arrives.  Memory use does not depend on file size.
+class DSDIFFReader {
+  public:
+    explicit DSDIFFReader(const std::filesystem::path &path);
+
+    [[nodiscard]] SampleRate sampleRate() const noexcept {
+        return static_cast<SampleRate>(Header_.fs.SampleRate);
+    }
+    [[nodiscard]] std::uint16_t numChannels() const noexcept {
+        return Header_.chnl.NumChannels;
+    }
+    // 1‑bit samples per channel, and how many have been read so far.
+    [[nodiscard]] std::uint64_t numSamples() const noexcept {
+        return Header_.numSamples();
+    }
+    [[nodiscard]] std::uint64_t position() const noexcept {
+        return Position_;
+    }
+
+    // Deliver the next I/O block into block, resized to numChannels() ×
+    // n / 8 bytes.  Returns n, the samples per channel it holds (always a
+    // multiple of 8); 0 once the stream is exhausted.
+    std::size_t read(AudioBuffer<std::uint8_t> &block);
+
+    // Read everything that is left straight into out, sized to hold it.
+    void readAll(AudioBuffer<std::uint8_t> &out);
+
+  private:
+    std::size_t decode(std::span<const std::uint8_t> frames,
+                       AudioBuffer<std::uint8_t> &out, std::size_t at);
+
+    headers::DSDIFF::DSDIFFHeader Header_;
+    std::optional<BlockReader> Reader_;
+    std::uint64_t Position_{0};
+};
+
+// ── Block‑wise writer for DSDIFF ─────────────────────────────────────────
+// Channels are interleaved straight into BlockWriter buffers.  The header
+// is written provisionally and its sizes patched by close().  DSDIFF only
+// counts whole bytes, so a final partial byte is kept as is and the sample
+// count rounds up to it.
+class DSDIFFWriter {
+  public:
+    DSDIFFWriter(const std::filesystem::path &path, SampleRate sampleRate,
+                 std::uint16_t numChannels);
+    ~DSDIFFWriter();
+
+    DSDIFFWriter(const DSDIFFWriter &) = delete;
+    DSDIFFWriter &operator=(const DSDIFFWriter &) = delete;
+
+    // Append the first `samples` samples of every channel of block, in the
+    // byte layout DSDIFFReader produces.  Only the last call may pass a
+    // count that is not a multiple of 8.
+    void write(const AudioBuffer<std::uint8_t> &block, std::uint64_t samples);
+
+    // Flush, pad the chunk to even length and finalise the header.  Called
+    // by the destructor if not done already, but only an explicit call
+    // reports errors.
+    void close();
+
+    [[nodiscard]] std::uint64_t samplesWritten() const noexcept {
+        return SamplesWritten_;
+    }
+
+  private:
+    std::ofstream File_;
+    headers::DSDIFF::DSDIFFHeader Header_;
+    std::optional<BlockWriter> Writer_;
+    std::span<std::uint8_t> Out_;
+    std::size_t Used_{0};
+    std::uint64_t SamplesWritten_{0};
+    bool Closed_{false};
+};
+
+} // namespace sk::io
+
+#endif // DSDIFFSTREAM_H
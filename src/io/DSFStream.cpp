@@ -0,0 +1,180 @@
+#include "DSFStream.h"
+
+#include "../lib/DSDCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// I/O block size rounded down to whole groups (at least one).
+std::size_t groupedBlockBytes(std::uint64_t groupSize) {
+    const auto group = static_cast<std::size_t>(groupSize);
+    return std::max(group, sk::io::kIOBlockBytes / group * group);
+}
+
+} // namespace
+
+// ─── DSFReader ────────────────────────────────────────────────────────────
+sk::io::DSFReader::DSFReader(const std::filesystem::path &path) {
+    std::uint64_t payload;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("open " + path.string());
+        Header_.read(file);
+        payload = static_cast<std::uint64_t>(file.tellg());
+    }
+
+    // Only the groups that carry samples are read; the data chunk may be
+    // followed by metadata, and some writers pad it further.
+    const std::uint64_t group = Header_.groupSize();
+    const std::uint64_t bytesPerChannel = (numSamples() + 7) / 8;
+    const std::uint64_t groups =
+        (bytesPerChannel + Header_.fmt.BlockSize - 1) / Header_.fmt.BlockSize;
+    if (groups * group > Header_.dataSize())
+        throw std::runtime_error("DSD payload short");
+    Reader_.emplace(path, payload, groups * group,
+                    static_cast<std::size_t>(group),
+                    groupedBlockBytes(group));
+}
+
+std::size_t sk::io::DSFReader::decode(std::span<const std::uint8_t> groups,
+                                      AudioBuffer<std::uint8_t> &out,
+                                      std::size_t at) {
+    const std::size_t blockSize = Header_.fmt.BlockSize;
+    const std::size_t ch = numChannels();
+    const std::uint64_t samples = std::min<std::uint64_t>(
+        groups.size() / ch * 8, numSamples() - Position_);
+    const auto bytes = static_cast<std::size_t>((samples + 7) / 8);
+    const bool reverse = Header_.lsbFirst();
+
+    for (std::size_t g = 0, done = 0; done < bytes; ++g, done += blockSize) {
+        const std::size_t n = std::min(blockSize, bytes - done);
+        const std::uint8_t *src = groups.data() + g * blockSize * ch;
+        for (std::size_t c = 0; c < ch; ++c)
+            sk::dsd::copyBits(src + c * blockSize,
+                              out.channel(c).data() + at + done, n, reverse);
+    }
+    Position_ += samples;
+    return static_cast<std::size_t>(samples);
+}
+
+std::size_t sk::io::DSFReader::read(AudioBuffer<std::uint8_t> &block) {
+    if (Position_ >= numSamples())
+        return 0;
+    const auto groups = Reader_->next();
+    if (groups.empty())
+        return 0;
+
+    const std::uint64_t samples = std::min<std::uint64_t>(
+        groups.size() / numChannels() * 8, numSamples() - Position_);
+    const auto bytes = static_cast<std::size_t>((samples + 7) / 8);
+    if (block.numChannels() != numChannels() || block.numFrames() != bytes)
+        block.resizeForOverwrite(numChannels(), bytes);
+    return decode(groups, block, 0);
+}
+
+void sk::io::DSFReader::readAll(AudioBuffer<std::uint8_t> &out) {
+    const std::uint64_t left = numSamples() - Position_;
+    out.resizeForOverwrite(numChannels(),
+                           static_cast<std::size_t>((left + 7) / 8));
+    std::size_t at = 0;
+    while (Position_ < numSamples()) {
+        const auto groups = Reader_->next();
+        if (groups.empty())
+            throw std::runtime_error("DSD payload short");
+        at += decode(groups, out, at) / 8;
+    }
+}
+
+// ─── DSFWriter ────────────────────────────────────────────────────────────
+sk::io::DSFWriter::DSFWriter(const std::filesystem::path &path,
+                             SampleRate sampleRate, std::uint16_t numChannels)
+    : File_(path, std::ios::binary) {
+    if (!File_)
+        throw std::runtime_error("create " + path.string());
+    // The header's size does not depend on the sample count, so it can be
+    // rewritten in place once the length is known.
+    Header_.update(static_cast<std::uint32_t>(sampleRate), numChannels, 0);
+    Header_.write(File_);
+    File_.flush();
+    if (!File_)
+        throw std::runtime_error("header write failed " + path.string());
+
+    Writer_.emplace(path, static_cast<std::uint64_t>(File_.tellp()),
+                    groupedBlockBytes(Header_.groupSize()));
+    Out_ = Writer_->buffer();
+}
+
+sk::io::DSFWriter::~DSFWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to observe errors.
+    }
+}
+
+void sk::io::DSFWriter::write(const AudioBuffer<std::uint8_t> &block,
+                              std::uint64_t samples) {
+    if (Closed_)
+        throw std::runtime_error("write to closed stream");
+    if (SamplesWritten_ % 8 != 0)
+        throw std::runtime_error("DSD samples after a partial byte");
+    const std::size_t ch = Header_.fmt.ChanNum;
+    const std::size_t blockSize = Header_.fmt.BlockSize;
+    const auto group = static_cast<std::size_t>(Header_.groupSize());
+    const auto bytes = static_cast<std::size_t>((samples + 7) / 8);
+    if (block.numChannels() != ch || block.numFrames() < bytes)
+        throw std::runtime_error("block shape does not match stream");
+
+    // Each channel's bytes go, bit‑reversed, directly into its block of the
+    // group currently open in the I/O buffer.
+    for (std::size_t pos = 0; pos < bytes;) {
+        if (Fill_ == 0 && Used_ + group > Out_.size()) {
+            Writer_->commit(Used_);
+            Out_ = Writer_->buffer();
+            Used_ = 0;
+        }
+        const std::size_t n = std::min(blockSize - Fill_, bytes - pos);
+        for (std::size_t c = 0; c < ch; ++c)
+            sk::dsd::reverseBits(block.channel(c).data() + pos,
+                                 Out_.data() + Used_ + c * blockSize + Fill_,
+                                 n);
+        Fill_ += n;
+        pos += n;
+        if (Fill_ == blockSize) {
+            Used_ += group;
+            Fill_ = 0;
+        }
+    }
+    SamplesWritten_ += samples;
+}
+
+void sk::io::DSFWriter::close() {
+    if (Closed_)
+        return;
+    Closed_ = true;
+
+    // The last group is zero padded to full blocks.
+    if (Fill_ > 0) {
+        const std::size_t blockSize = Header_.fmt.BlockSize;
+        for (std::size_t c = 0; c < Header_.fmt.ChanNum; ++c)
+            std::memset(Out_.data() + Used_ + c * blockSize + Fill_, 0,
+                        blockSize - Fill_);
+        Used_ += static_cast<std::size_t>(Header_.groupSize());
+        Fill_ = 0;
+    }
+    if (Used_ > 0)
+        Writer_->commit(Used_);
+    Writer_->finish();
+
+    Header_.update(Header_.fmt.SampleRate,
+                   static_cast<std::uint16_t>(Header_.fmt.ChanNum),
+                   SamplesWritten_);
+    File_.seekp(0);
+    Header_.write(File_);
+    File_.close();
+    if (!File_)
+        throw std::runtime_error("DSF header write failed");
+}
@@ -0,0 +1,98 @@
+#ifndef DSFSTREAM_H
+#define DSFSTREAM_H
+
+#include "../AudioTypes.h"
+#include "../headers/DSFHeaders.h"
+#include "AsyncIO.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+
+namespace sk::io {
+
+// ── Block‑wise reader for DSF ────────────────────────────────────────────
+// The payload arrives through a BlockReader in whole block groups (one
+// BlockSize‑byte block per channel), so nothing larger than an I/O block is
+// ever held.  Each channel is handed out as a byte stream in SineKit's DSD
+// order: eight samples per byte, oldest in the most significant bit.
+class DSFReader {
+  public:
+    explicit DSFReader(const std::filesystem::path &path);
+
+    [[nodiscard]] SampleRate sampleRate() const noexcept {
+        return static_cast<SampleRate>(Header_.fmt.SampleRate);
+    }
+    [[nodiscard]] std::uint16_t numChannels() const noexcept {
+        return static_cast<std::uint16_t>(Header_.fmt.ChanNum);
+    }
+    // 1‑bit samples per channel, and how many have been read so far.
+    [[nodiscard]] std::uint64_t numSamples() const noexcept {
+        return Header_.fmt.NumSamples;
+    }
+    [[nodiscard]] std::uint64_t position() const noexcept {
+        return Position_;
+    }
+
+    // Deliver the next I/O block's worth of groups into block, resized to
+    // numChannels() × ceil(n / 8) bytes.  Returns n, the samples per channel
+    // it holds; 0 once the stream is exhausted.  n is a multiple of 8 on
+    // every call but the last.
+    std::size_t read(AudioBuffer<std::uint8_t> &block);
+
+    // Read everything that is left straight into out, sized to hold it.
+    void readAll(AudioBuffer<std::uint8_t> &out);
+
+  private:
+    // Deinterleave the groups of one I/O block into every channel of out
+    // from byte `at` onwards; returns the samples per channel decoded.
+    std::size_t decode(std::span<const std::uint8_t> groups,
+                       AudioBuffer<std::uint8_t> &out, std::size_t at);
+
+    headers::DSF::DSFHeader Header_;
+    std::optional<BlockReader> Reader_;
+    std::uint64_t Position_{0};
+};
+
+// ── Block‑wise writer for DSF ────────────────────────────────────────────
+// Bytes are bit‑reversed straight into the group being assembled inside a
+// BlockWriter buffer, so whole channels never have to be materialised.  A
+// provisional header is written on construction and patched by close().
+class DSFWriter {
+  public:
+    DSFWriter(const std::filesystem::path &path, SampleRate sampleRate,
+              std::uint16_t numChannels);
+    ~DSFWriter();
+
+    DSFWriter(const DSFWriter &) = delete;
+    DSFWriter &operator=(const DSFWriter &) = delete;
+
+    // Append the first `samples` samples of every channel of block, in the
+    // byte layout DSFReader produces.  Only the last call may pass a count
+    // that is not a multiple of 8.
+    void write(const AudioBuffer<std::uint8_t> &block, std::uint64_t samples);
+
+    // Pad the last group, flush and finalise the header.  Called by the
+    // destructor if not done already, but only an explicit call reports
+    // errors.
+    void close();
+
+    [[nodiscard]] std::uint64_t samplesWritten() const noexcept {
+        return SamplesWritten_;
+    }
+
+  private:
+    std::ofstream File_;
+    headers::DSF::DSFHeader Header_;
+    std::optional<BlockWriter> Writer_;
+    std::span<std::uint8_t> Out_;
+    std::size_t Used_{0};
+    std::size_t Fill_{0};
+    std::uint64_t SamplesWritten_{0};
+    bool Closed_{false};
+};
+
+} // namespace sk::io
+
+#endif // DSFSTREAM_H
@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+sk::io::MappedFile::MappedFile(MappedFile &&other) noexcept
+    : Data_(std::exchange(other.Data_, nullptr)),
+      Size_(std::exchange(other.Size_, 0)) {
+#ifdef _WIN32
+    Mapping_ = std::exchange(other.Mapping_, nullptr);
+#endif
+}
+
+sk::io::MappedFile &
+sk::io::MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        Data_ = std::exchange(other.Data_, nullptr);
+        Size_ = std::exchange(other.Size_, 0);
+#ifdef _WIN32
+        Mapping_ = std::exchange(other.Mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+void sk::io::MappedFile::open(const std::filesystem::path &path) {
+    close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("open " + path.string());
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        throw std::runtime_error("empty or unreadable file " + path.string());
+    }
+
+    HANDLE mapping =
+        CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+        throw std::runtime_error("mmap " + path.string());
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        throw std::runtime_error("mmap " + path.string());
+    }
+    Mapping_ = mapping;
+    Data_ = static_cast<const std::uint8_t *>(view);
+    Size_ = static_cast<std::size_t>(size.QuadPart);
+}
+
+void sk::io::MappedFile::close() noexcept {
+    if (Data_ != nullptr)
+        UnmapViewOfFile(Data_);
+    if (Mapping_ != nullptr)
+        CloseHandle(Mapping_);
+    Data_ = nullptr;
+    Mapping_ = nullptr;
+    Size_ = 0;
+}
+
+#else
+
+void sk::io::MappedFile::open(const std::filesystem::path &path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("open " + path.string());
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("empty or unreadable file " + path.string());
+    }
+
+    void *addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size),
+                        PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        throw std::runtime_error("mmap " + path.string());
+
+    Data_ = static_cast<const std::uint8_t *>(addr);
+    Size_ = static_cast<std::size_t>(st.st_size);
+}
+
+void sk::io::MappedFile::close() noexcept {
+    if (Data_ != nullptr)
+        ::munmap(const_cast<std::uint8_t *>(Data_), Size_);
+    Data_ = nullptr;
+    Size_ = 0;
+}
+
+#endif
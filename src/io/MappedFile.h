@@ -0,0 +1,42 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace sk::io {
+
+// ── Read‑only memory mapping of a whole file ─────────────────────────────
+// Lets headers and small files (a saved filter cache) be parsed in place
+// without copying them into a buffer; audio payloads are streamed
+// separately.  The mapping is released on destruction.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path &path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    void open(const std::filesystem::path &path);
+    void close() noexcept;
+
+    [[nodiscard]] bool isOpen() const noexcept { return Data_ != nullptr; }
+    [[nodiscard]] const std::uint8_t *data() const noexcept { return Data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return Size_; }
+
+  private:
+    const std::uint8_t *Data_{nullptr};
+    std::size_t Size_{0};
+#ifdef _WIN32
+    void *Mapping_{nullptr};
+#endif
+};
+
+} // namespace sk::io
+
+#endif // MAPPEDFILE_H
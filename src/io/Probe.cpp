@@ -0,0 +1,151 @@
+#include "Probe.h"
+
+#include "../headers/AIFFHeaders.h"
+#include "../headers/DSDIFFHeaders.h"
+#include "../headers/DSFHeaders.h"
+#include "../headers/WAVHeaders.h"
+#include "../lib/Parallel.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+sk::ProbeInfo probeWAV(std::ifstream &file) {
+    sk::headers::WAV::WAVHeader header;
+    header.read(file);
+    sk::ProbeInfo info;
+    info.Format = sk::io::Container::WAV;
+    info.IsFloat = header.isFloat();
+    info.Depth = sk::pcmBitType(header.fmt.BitsPerSample, info.IsFloat);
+    info.Rate = static_cast<sk::SampleRate>(header.fmt.SampleRate);
+    info.NumChannels = header.fmt.NumChannels;
+    info.ByteOrder = sk::endian::Endian::Little;
+    info.NumFrames = header.numFrames();
+    info.DataOffset = static_cast<std::uint64_t>(file.tellg());
+    info.DataSize = header.dataSize();
+    return info;
+}
+
+sk::ProbeInfo probeAIFF(std::ifstream &file) {
+    sk::headers::AIFF::AIFFHeader header;
+    header.read(file);
+    sk::ProbeInfo info;
+    info.Format = sk::io::Container::AIFF;
+    info.IsFloat = header.isFloat();
+    info.Depth = sk::pcmBitType(static_cast<unsigned>(header.comm.BitDepth),
+                                info.IsFloat);
+    info.Rate = static_cast<sk::SampleRate>(
+        static_cast<std::uint32_t>(header.comm.SampleRate));
+    info.NumChannels = static_cast<std::uint16_t>(header.comm.NumChannels);
+    info.ByteOrder = header.byteOrder();
+    info.NumFrames = header.comm.NumSamples;
+    info.DataOffset = static_cast<std::uint64_t>(file.tellg());
+    info.DataSize = info.NumFrames * info.NumChannels *
+                    static_cast<std::uint64_t>(header.comm.BitDepth) / 8;
+    return info;
+}
+
+sk::ProbeInfo probeDSF(std::ifstream &file) {
+    sk::headers::DSF::DSFHeader header;
+    header.read(file);
+    sk::ProbeInfo info;
+    info.Format = sk::io::Container::DSF;
+    info.Depth = sk::BitType::D1;
+    info.Rate = static_cast<sk::SampleRate>(header.fmt.SampleRate);
+    info.NumChannels = static_cast<std::uint16_t>(header.fmt.ChanNum);
+    info.ByteOrder = sk::endian::Endian::Little;
+    info.NumFrames = header.fmt.NumSamples;
+    info.DataOffset = static_cast<std::uint64_t>(file.tellg());
+    info.DataSize = header.dataSize();
+    return info;
+}
+
+sk::ProbeInfo probeDSDIFF(std::ifstream &file) {
+    sk::headers::DSDIFF::DSDIFFHeader header;
+    header.read(file);
+    sk::ProbeInfo info;
+    info.Format = sk::io::Container::DSDIFF;
+    info.Depth = sk::BitType::D1;
+    info.Rate = static_cast<sk::SampleRate>(header.fs.SampleRate);
+    info.NumChannels = header.chnl.NumChannels;
+    info.ByteOrder = sk::endian::Endian::Big;
+    info.NumFrames = header.numSamples();
+    info.DataOffset = static_cast<std::uint64_t>(file.tellg());
+    info.DataSize = header.data.ChunkSize;
+    return info;
+}
+
+// The extensions containerFor() and SineKit::loadFile() accept, so every
+// file collected can also be converted.
+bool isAudioExtension(const std::filesystem::path &path) {
+    const auto ext = path.extension();
+    return ext == ".wav" || ext == ".aiff" || ext == ".dsf" || ext == ".dff";
+}
+
+} // namespace
+
+sk::ProbeInfo sk::probe(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("open " + path.string());
+
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    if (!file)
+        throw std::runtime_error("file too short " + path.string());
+    file.seekg(0);
+
+    if (std::strncmp(magic, "RIFF", 4) == 0 ||
+        std::strncmp(magic, "RF64", 4) == 0 ||
+        std::strncmp(magic, "BW64", 4) == 0)
+        return probeWAV(file);
+    if (std::strncmp(magic, "FORM", 4) == 0)
+        return probeAIFF(file);
+    if (std::strncmp(magic, "DSD ", 4) == 0)
+        return probeDSF(file);
+    if (std::strncmp(magic, "FRM8", 4) == 0)
+        return probeDSDIFF(file);
+    throw std::runtime_error("unrecognised container " + path.string());
+}
+
+std::vector<sk::ProbeResult>
+sk::probeAll(std::span<const std::filesystem::path> paths, unsigned threads) {
+    std::vector<ProbeResult> results(paths.size());
+    // Probing is dominated by open() and a couple of small reads, so
+    // per‑item cost is roughly uniform.  Errors stay in their result, so
+    // no item throws and every file is probed.
+    sk::parallel::forEach(
+        paths.size(),
+        [&](std::size_t i) {
+            ProbeResult &result = results[i];
+            result.Path = paths[i];
+            try {
+                result.Info = probe(paths[i]);
+            } catch (const std::exception &e) {
+                result.Error = e.what();
+            }
+        },
+        threads);
+    return results;
+}
+
+std::vector<sk::ProbeResult>
+sk::probeDirectory(const std::filesystem::path &root, unsigned threads) {
+    namespace fs = std::filesystem;
+    std::vector<fs::path> paths;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator
+             it(root, fs::directory_options::skip_permission_denied, ec),
+         end;
+         it != end; it.increment(ec)) {
+        if (ec)
+            break;
+        if (it->is_regular_file(ec) && isAudioExtension(it->path()))
+            paths.push_back(it->path());
+    }
+    if (ec && paths.empty())
+        throw std::runtime_error("cannot list " + root.string() + ": " +
+                                 ec.message());
+    return probeAll(paths, threads);
+}
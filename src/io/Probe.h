@@ -0,0 +1,61 @@
+#ifndef PROBE_H
+#define PROBE_H
+
+#include "../AudioTypes.h"
+#include "Container.h"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sk {
+
+// ── Metadata‑only view of an audio file ──────────────────────────────────
+// Everything needed to plan a job without touching a single sample.
+struct ProbeInfo {
+    io::Container Format{io::Container::WAV};
+    BitType Depth{BitType::Undefined};
+    SampleRate Rate{SampleRate::Undefined};
+    std::uint16_t NumChannels{0};
+    bool IsFloat{false};
+    endian::Endian ByteOrder{endian::Endian::Little};
+    std::uint64_t NumFrames{0};
+    // Byte offset and length of the sample payload within the file.
+    std::uint64_t DataOffset{0};
+    std::uint64_t DataSize{0};
+};
+
+// Read the container header of path and nothing else.  The format is
+// recognised from its magic bytes, not the extension; chunks the reader
+// does not need are skipped by their declared size.  Throws on files that
+// are not WAV (RIFF/RF64/BW64), AIFF/AIFF‑C, DSF or DSDIFF.  32‑bit
+// integer PCM has Depth I32.  For DSD files, Depth is D1 and NumFrames
+// counts 1‑bit samples per channel.
+[[nodiscard]] ProbeInfo probe(const std::filesystem::path &path);
+
+struct ProbeResult {
+    std::filesystem::path Path;
+    ProbeInfo Info;
+    // Empty on success, otherwise the reason the file could not be probed.
+    std::string Error;
+
+    [[nodiscard]] bool ok() const noexcept { return Error.empty(); }
+};
+
+// Probe many files on `threads` workers (0 = this thread's
+// parallel::ThreadBudget, or one per hardware thread without one).
+// Results are returned in input order; a bad file is reported in its
+// result instead of aborting the batch.
+[[nodiscard]] std::vector<ProbeResult>
+probeAll(std::span<const std::filesystem::path> paths, unsigned threads = 0);
+
+// Recursively collect every .wav/.aiff/.dsf/.dff file below root (the
+// extensions the readers accept, matched exactly as they match them) and
+// probe them in parallel.  Unreadable directories are skipped.
+[[nodiscard]] std::vector<ProbeResult>
+probeDirectory(const std::filesystem::path &root, unsigned threads = 0);
+
+} // namespace sk
+
+#endif // PROBE_H
@@ -0,0 +1,206 @@
+#include "StreamConvert.h"
+
+#include "../dsp/BitDepth.h"
+#include "../dsp/Dither.h"
+#include "../headers/AIFFHeaders.h"
+#include "../headers/WAVHeaders.h"
+#include "../lib/PCMCodec.h"
+#include "AsyncIO.h"
+#include "Container.h"
+#include "Probe.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Bytes one sample occupies in a WAV / AIFF payload.
+std::size_t payloadWidth(sk::BitType depth) {
+    return depth == sk::BitType::I24 ? 3 : sk::bitsPerSample(depth) / 8;
+}
+
+// Write the final header of output and return the payload's offset and
+// byte order.  The pad byte goes in now, which also sizes the file.
+std::pair<std::uint64_t, sk::endian::Endian>
+writeFinalHeader(const std::filesystem::path &output, sk::BitType depth,
+            const sk::ProbeInfo &info) {
+    const std::uint16_t bits = sk::bitsPerSample(depth);
+    const bool isFloat = depth == sk::BitType::F32 ||
+                         depth == sk::BitType::F64;
+    const auto rate = static_cast<std::uint32_t>(info.Rate);
+    const std::uint64_t dataBytes =
+        info.NumFrames * info.NumChannels * payloadWidth(depth);
+
+    std::ofstream file(output, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("create " + output.string());
+    sk::endian::Endian order = sk::endian::Endian::Little;
+    switch (sk::io::containerFor(output)) {
+    case sk::io::Container::WAV: {
+        sk::headers::WAV::WAVHeader header;
+        header.update(bits, rate, info.NumChannels, info.NumFrames, isFloat);
+        header.write(file);
+        break;
+    }
+    case sk::io::Container::AIFF: {
+        sk::headers::AIFF::AIFFHeader header;
+        header.update(bits, rate, info.NumChannels, info.NumFrames, isFloat);
+        header.write(file);
+        order = header.byteOrder();
+        break;
+    }
+    default:
+        throw std::runtime_error("fused conversion writes WAV or AIFF");
+    }
+    const auto offset = static_cast<std::uint64_t>(file.tellp());
+    if (dataBytes & 1) {
+        file.seekp(static_cast<std::streamoff>(offset + dataBytes));
+        file.put(0);
+    }
+    file.close();
+    if (!file)
+        throw std::runtime_error("header write failed " + output.string());
+    return {offset, order};
+}
+
+} // namespace
+
+std::uint64_t sk::io::convertFile(const std::filesystem::path &input,
+                                  const std::filesystem::path &output,
+                                  BitType bitType, std::size_t blockFrames,
+                                  DitherAmount dither, NoiseShaping shaping) {
+    StreamReader reader(input);
+    StreamWriter writer(output, bitType, reader.sampleRate(),
+                        reader.numChannels());
+    const BitType from = reader.bitType();
+    const std::size_t ch = reader.numChannels();
+    const sk::dsp::Converter convert = sk::dsp::converter(from, bitType);
+    std::uint64_t clipped = 0;
+    std::optional<sk::dsp::Dither> ditherer;
+    if ((dither != DitherAmount::None || shaping != NoiseShaping::None) &&
+        sk::dsp::Dither::applies(from, bitType))
+        ditherer.emplace(dither, shaping, ch);
+    withSampleType(from, [&](auto fromType) {
+        using From = typename decltype(fromType)::type;
+        withSampleType(bitType, [&](auto toType) {
+            using To = typename decltype(toType)::type;
+            AudioBuffer<From> in;
+            AudioBuffer<To> out;
+            while (const std::size_t n = reader.read(in, blockFrames)) {
+                if (out.numChannels() != ch || out.numFrames() != n)
+                    out.resizeForOverwrite(ch, n);
+                if (ditherer) {
+                    std::vector<const From *> src(ch);
+                    std::vector<To *> dst(ch);
+                    for (std::size_t c = 0; c < ch; ++c) {
+                        src[c] = in.channel(c).data();
+                        dst[c] = out.channel(c).data();
+                    }
+                    clipped += ditherer->process(src.data(), dst.data(), n,
+                                                 from, bitType);
+                } else {
+                    for (std::size_t c = 0; c < ch; ++c)
+                        clipped += convert(in.channel(c).data(),
+                                           out.channel(c).data(), n);
+                }
+                writer.write(out, n);
+            }
+        });
+    });
+    writer.close();
+    return clipped;
+}
+
+std::uint64_t sk::io::convertFileFused(const std::filesystem::path &input,
+                                       const std::filesystem::path &output,
+                                       BitType bitType, DitherAmount dither,
+                                       NoiseShaping shaping) {
+    const ProbeInfo info = probe(input);
+    const BitType from = info.Depth;
+    if (info.Format != Container::WAV && info.Format != Container::AIFF)
+        throw std::runtime_error("fused conversion reads WAV or AIFF");
+    // Checked before anything is written; the step size divides by it.
+    if (info.NumChannels == 0)
+        throw std::runtime_error("input has no channels");
+    // SineKit's 8‑bit samples are unsigned, as WAV has them; AIFF's are
+    // signed.
+    if ((from == BitType::I8 && info.Format == Container::AIFF) ||
+        (bitType == BitType::I8 && containerFor(output) == Container::AIFF))
+        throw std::runtime_error("8-bit audio must be WAV");
+    const sk::dsp::Converter convert = sk::dsp::converter(from, bitType);
+    const auto [offset, order] = writeFinalHeader(output, bitType, info);
+
+    const std::size_t ch = info.NumChannels;
+    const std::size_t inFrame = ch * payloadWidth(from);
+    const std::size_t outFrame = ch * payloadWidth(bitType);
+    std::optional<sk::dsp::Dither> ditherer;
+    if ((dither != DitherAmount::None || shaping != NoiseShaping::None) &&
+        sk::dsp::Dither::applies(from, bitType))
+        ditherer.emplace(dither, shaping, ch);
+
+    std::uint64_t clipped = 0;
+    withSampleType(from, [&]<typename From>(std::type_identity<From>) {
+        withSampleType(bitType, [&]<typename To>(std::type_identity<To>) {
+            const std::size_t step = std::max<std::size_t>(
+                1, kFusedStepBytes / (ch * (sizeof(From) + sizeof(To))));
+            std::vector<From, sk::pool::Allocator<From>> in(step * ch);
+            std::vector<To, sk::pool::Allocator<To>> out(step * ch);
+            // Planar views, one run of `step` per channel, for dither.
+            std::vector<From *> inPlanes(ch);
+            std::vector<To *> outPlanes(ch);
+            for (std::size_t c = 0; c < ch; ++c) {
+                inPlanes[c] = in.data() + c * step;
+                outPlanes[c] = out.data() + c * step;
+            }
+            From *inRun = in.data();
+            To *outRun = out.data();
+
+            BlockReader reader(input, info.DataOffset,
+                               info.NumFrames * inFrame, inFrame);
+            BlockWriter writer(output, offset);
+            std::span<std::uint8_t> block = writer.buffer();
+            std::size_t used = 0;
+            for (auto raw = reader.next(); !raw.empty(); raw = reader.next()) {
+                const std::size_t frames = raw.size() / inFrame;
+                for (std::size_t f0 = 0; f0 < frames;) {
+                    if (block.size() - used < outFrame) {
+                        writer.commit(used);
+                        block = writer.buffer();
+                        used = 0;
+                    }
+                    const std::size_t n =
+                        std::min({step, frames - f0,
+                                  (block.size() - used) / outFrame});
+                    const std::uint8_t *src = raw.data() + f0 * inFrame;
+                    std::uint8_t *dst = block.data() + used;
+                    if (ditherer) {
+                        sk::pcm::decode(src, inPlanes.data(), n, ch,
+                                        info.ByteOrder, payloadWidth(from));
+                        clipped += ditherer->process(inPlanes.data(),
+                                                     outPlanes.data(), n,
+                                                     from, bitType);
+                        sk::pcm::encode(outPlanes.data(), dst, n, ch, order,
+                                        payloadWidth(bitType));
+                    } else {
+                        // Interleaved runs convert as one channel.
+                        sk::pcm::decode(src, &inRun, n * ch, 1,
+                                        info.ByteOrder, payloadWidth(from));
+                        clipped += convert(in.data(), out.data(), n * ch);
+                        sk::pcm::encode(&outRun, dst, n * ch, 1, order,
+                                        payloadWidth(bitType));
+                    }
+                    used += n * outFrame;
+                    f0 += n;
+                }
+            }
+            writer.commit(used);
+            writer.finish();
+        });
+    });
+    return clipped;
+}
@@ -0,0 +1,44 @@
+#ifndef STREAMCONVERT_H
+#define STREAMCONVERT_H
+
+#include "../AudioTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace sk::io {
+
+inline constexpr std::size_t kDefaultStreamBlockFrames = 65536;
+// Decoded plus converted samples of one convertFileFused step; small
+// enough to stay in L2 beside the I/O blocks being worked on.
+inline constexpr std::size_t kFusedStepBytes = std::size_t{128} << 10;
+
+// Re‑encode input at a new bit depth (and/or container, by output
+// extension) one block at a time.  Peak memory is a few blocks regardless
+// of file length.  Dither and noise shaping apply as in
+// SineKit::toBitDepth, each channel's ditherer carrying its state from one
+// block to the next.  Returns the number of samples clipped.
+std::uint64_t convertFile(const std::filesystem::path &input,
+                          const std::filesystem::path &output,
+                          BitType bitType,
+                          std::size_t blockFrames = kDefaultStreamBlockFrames,
+                          DitherAmount dither = DitherAmount::None,
+                          NoiseShaping shaping = NoiseShaping::None);
+
+// The same conversion in a single pass over the payload.  Each read‑ahead
+// block is decoded, converted and encoded kFusedStepBytes at a time
+// straight into a write‑behind block, so a step's intermediates never
+// leave the cache and no whole‑file or whole‑block sample buffer exists:
+// the payload is read once and written once.  Undithered conversion skips
+// deinterleaving, since every sample converts on its own.  The output
+// header is final from the start.  Input must be WAV or AIFF, including
+// 32‑bit integer PCM; 8‑bit audio must be WAV on both sides.
+std::uint64_t convertFileFused(const std::filesystem::path &input,
+                               const std::filesystem::path &output,
+                               BitType bitType,
+                               DitherAmount dither = DitherAmount::None,
+                               NoiseShaping shaping = NoiseShaping::None);
+
+} // namespace sk::io
+
+#endif // STREAMCONVERT_H
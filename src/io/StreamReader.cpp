@@ -0,0 +1,100 @@
+#include "StreamReader.h"
+
+#include "../lib/PCMCodec.h"
+#include <algorithm>
+#include <stdexcept>
+
+sk::io::StreamReader::StreamReader(const std::filesystem::path &path)
+    : File_(path, std::ios::binary), Container_(containerFor(path)) {
+    if (!File_)
+        throw std::runtime_error("open " + path.string());
+
+    switch (Container_) {
+    case Container::WAV:
+        WAVHeader_.read(File_);
+        NumChannels_ = WAVHeader_.fmt.NumChannels;
+        SampleRate_ = static_cast<SampleRate>(WAVHeader_.fmt.SampleRate);
+        BitType_ = pcmBitType(WAVHeader_.fmt.BitsPerSample,
+                              WAVHeader_.isFloat());
+        NumFrames_ = WAVHeader_.numFrames();
+        ByteOrder_ = endian::Endian::Little;
+        break;
+    case Container::AIFF:
+        AIFFHeader_.read(File_);
+        NumChannels_ = AIFFHeader_.comm.NumChannels;
+        SampleRate_ = static_cast<SampleRate>(
+            static_cast<std::uint32_t>(AIFFHeader_.comm.SampleRate));
+        BitType_ = pcmBitType(
+            static_cast<unsigned>(AIFFHeader_.comm.BitDepth),
+            AIFFHeader_.isFloat());
+        NumFrames_ = AIFFHeader_.comm.NumSamples;
+        ByteOrder_ = AIFFHeader_.byteOrder();
+        break;
+    case Container::DSF:
+        throw std::runtime_error("DSF holds DSD, not PCM; use DSFReader");
+    case Container::DSDIFF:
+        throw std::runtime_error(
+            "DSDIFF holds DSD, not PCM; use DSDIFFReader");
+    }
+
+    switch (BitType_) {
+    case BitType::I8:
+        // 8‑bit AIFF is signed; SineKit keeps 8‑bit samples unsigned.
+        if (Container_ == Container::AIFF)
+            throw std::runtime_error("8-bit audio must be WAV");
+        [[fallthrough]];
+    case BitType::I16:
+    case BitType::I32:
+    case BitType::F32:
+    case BitType::F64:
+        Width_ = bitsPerSample(BitType_) / 8;
+        break;
+    case BitType::I24:
+        Width_ = 3;
+        break;
+    default:
+        throw std::runtime_error("unsupported depth");
+    }
+    if (!File_)
+        throw std::runtime_error("header read failed " + path.string());
+}
+
+template <typename T>
+std::size_t sk::io::StreamReader::read(AudioBuffer<T> &block,
+                                       std::size_t maxFrames) {
+    if (Width_ != sizeof(T) && !(Width_ == 3 && sizeof(T) == 4))
+        throw std::runtime_error("sample type does not match stream depth");
+
+    const auto n = static_cast<std::size_t>(
+        std::min<std::uint64_t>(maxFrames, NumFrames_ - Position_));
+    if (n == 0)
+        return 0;
+
+    Raw_.resize(n * NumChannels_ * Width_);
+    File_.read(reinterpret_cast<char *>(Raw_.data()),
+               static_cast<std::streamsize>(Raw_.size()));
+    if (!File_)
+        throw std::runtime_error("PCM payload short");
+
+    if (block.numChannels() != NumChannels_ || block.numFrames() != n)
+        block.resizeForOverwrite(NumChannels_, n);
+    std::vector<T *> planes(NumChannels_);
+    for (std::size_t c = 0; c < NumChannels_; ++c)
+        planes[c] = block.channel(c).data();
+    sk::pcm::decode(Raw_.data(), planes.data(), n, NumChannels_,
+                    ByteOrder_, Width_);
+
+    Position_ += n;
+    return n;
+}
+
+template std::size_t
+sk::io::StreamReader::read(AudioBuffer<std::uint8_t> &, std::size_t);
+template std::size_t
+sk::io::StreamReader::read(AudioBuffer<std::int16_t> &, std::size_t);
+template std::size_t
+sk::io::StreamReader::read(AudioBuffer<std::int32_t> &, std::size_t);
+template std::size_t sk::io::StreamReader::read(AudioBuffer<float> &,
+                                                std::size_t);
+template std::size_t sk::io::StreamReader::read(AudioBuffer<double> &,
+                                                std::size_t);
@@ -0,0 +1,62 @@
+#ifndef STREAMREADER_H
+#define STREAMREADER_H
+
+#include "../AudioTypes.h"
+#include "../headers/AIFFHeaders.h"
+#include "../headers/WAVHeaders.h"
+#include "Container.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace sk::io {
+
+// ── Block‑wise PCM decoder for WAV / AIFF ────────────────────────────────
+// Only the header is parsed up front; samples are pulled on demand in
+// blocks of at most `maxFrames`, so memory use is bounded by the block size
+// rather than by the length of the file.
+class StreamReader {
+  public:
+    explicit StreamReader(const std::filesystem::path &path);
+
+    [[nodiscard]] Container container() const noexcept { return Container_; }
+    [[nodiscard]] BitType bitType() const noexcept { return BitType_; }
+    [[nodiscard]] SampleRate sampleRate() const noexcept {
+        return SampleRate_;
+    }
+    [[nodiscard]] std::uint16_t numChannels() const noexcept {
+        return NumChannels_;
+    }
+    [[nodiscard]] std::uint64_t numFrames() const noexcept {
+        return NumFrames_;
+    }
+    [[nodiscard]] std::uint64_t position() const noexcept {
+        return Position_;
+    }
+
+    // Decode up to maxFrames frames into block, which is resized to
+    // numChannels() × n.  Returns n; 0 once the stream is exhausted.  T must
+    // be the in‑memory sample type of bitType() (see withSampleType).
+    template <typename T>
+    std::size_t read(AudioBuffer<T> &block, std::size_t maxFrames);
+
+  private:
+    std::ifstream File_;
+    headers::WAV::WAVHeader WAVHeader_;
+    headers::AIFF::AIFFHeader AIFFHeader_;
+    Container Container_;
+    // AIFF‑C 'sowt' payloads are little‑endian despite the container.
+    endian::Endian ByteOrder_{endian::Endian::Little};
+    BitType BitType_{BitType::Undefined};
+    SampleRate SampleRate_{SampleRate::Undefined};
+    std::uint16_t NumChannels_{0};
+    std::uint64_t NumFrames_{0};
+    std::uint64_t Position_{0};
+    std::size_t Width_{0};
+    std::vector<std::uint8_t> Raw_;
+};
+
+} // namespace sk::io
+
+#endif // STREAMREADER_H
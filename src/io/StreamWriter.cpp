@@ -0,0 +1,125 @@
+#include "StreamWriter.h"
+
+#include "../lib/PCMCodec.h"
+#include <stdexcept>
+
+sk::io::StreamWriter::StreamWriter(const std::filesystem::path &path,
+                                   BitType bitType, SampleRate sampleRate,
+                                   std::uint16_t numChannels)
+    : File_(path, std::ios::binary), Container_(containerFor(path)),
+      BitType_(bitType), SampleRate_(sampleRate), NumChannels_(numChannels) {
+    if (!File_)
+        throw std::runtime_error("create " + path.string());
+
+    switch (BitType_) {
+    case BitType::I8:
+        // 8‑bit AIFF is signed; SineKit keeps 8‑bit samples unsigned.
+        if (Container_ == Container::AIFF)
+            throw std::runtime_error("8-bit audio must be WAV");
+        [[fallthrough]];
+    case BitType::I16:
+    case BitType::I32:
+    case BitType::F32:
+    case BitType::F64:
+        Width_ = bitsPerSample(BitType_) / 8;
+        break;
+    case BitType::I24:
+        Width_ = 3;
+        break;
+    default:
+        throw std::runtime_error("unsupported depth");
+    }
+    // The final length is unknown, so keep room for a ds64 chunk.
+    WAVHeader_.reserveDS64 = true;
+    writeHeader();
+}
+
+sk::io::StreamWriter::~StreamWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to observe errors.
+    }
+}
+
+void sk::io::StreamWriter::writeHeader() {
+    const std::uint16_t bits = bitsPerSample(BitType_);
+    const auto rate = static_cast<std::uint32_t>(SampleRate_);
+    const bool isFloat = BitType_ == BitType::F32 || BitType_ == BitType::F64;
+
+    // Header size does not depend on the frame count (a WAV that outgrows
+    // RIFF swaps its reserved JUNK chunk for ds64), so rewriting it in place
+    // at close() never disturbs the payload.
+    switch (Container_) {
+    case Container::WAV:
+        WAVHeader_.update(bits, rate, NumChannels_, FramesWritten_, isFloat);
+        WAVHeader_.write(File_);
+        break;
+    case Container::AIFF:
+        AIFFHeader_.update(bits, rate, NumChannels_, FramesWritten_,
+                           isFloat);
+        AIFFHeader_.write(File_);
+        break;
+    case Container::DSF:
+        throw std::runtime_error("DSF holds DSD, not PCM; use DSFWriter");
+    case Container::DSDIFF:
+        throw std::runtime_error(
+            "DSDIFF holds DSD, not PCM; use DSDIFFWriter");
+    }
+}
+
+template <typename T>
+void sk::io::StreamWriter::write(const AudioBuffer<T> &block,
+                                 std::size_t frames) {
+    if (Closed_)
+        throw std::runtime_error("write to closed stream");
+    if (Width_ != sizeof(T) && !(Width_ == 3 && sizeof(T) == 4))
+        throw std::runtime_error("sample type does not match stream depth");
+    if (block.numChannels() != NumChannels_ || block.numFrames() < frames)
+        throw std::runtime_error("block shape does not match stream");
+    if (Container_ == Container::AIFF &&
+        (FramesWritten_ + frames) * NumChannels_ * Width_ >
+            headers::AIFF::kMaxSoundBytes)
+        throw std::runtime_error("AIFF cannot hold more than 4 GiB of audio");
+
+    std::vector<const T *> planes(NumChannels_);
+    for (std::size_t c = 0; c < NumChannels_; ++c)
+        planes[c] = block.channel(c).data();
+
+    Raw_.resize(frames * NumChannels_ * Width_);
+    sk::pcm::encode(planes.data(), Raw_.data(), frames, NumChannels_,
+                    endianFor(Container_), Width_);
+    File_.write(reinterpret_cast<const char *>(Raw_.data()),
+                static_cast<std::streamsize>(Raw_.size()));
+    if (!File_)
+        throw std::runtime_error("PCM payload write failed");
+    FramesWritten_ += frames;
+}
+
+void sk::io::StreamWriter::close() {
+    if (Closed_)
+        return;
+    Closed_ = true;
+
+    // RIFF and IFF chunks are word aligned.
+    const std::uint64_t payload = FramesWritten_ * NumChannels_ * Width_;
+    if (payload & 1)
+        File_.put(0);
+
+    File_.seekp(0);
+    writeHeader();
+    File_.close();
+    if (!File_)
+        throw std::runtime_error("finalising stream header failed");
+}
+
+template void sk::io::StreamWriter::write(const AudioBuffer<std::uint8_t> &,
+                                          std::size_t);
+template void sk::io::StreamWriter::write(const AudioBuffer<std::int16_t> &,
+                                          std::size_t);
+template void sk::io::StreamWriter::write(const AudioBuffer<std::int32_t> &,
+                                          std::size_t);
+template void sk::io::StreamWriter::write(const AudioBuffer<float> &,
+                                          std::size_t);
+template void sk::io::StreamWriter::write(const AudioBuffer<double> &,
+                                          std::size_t);
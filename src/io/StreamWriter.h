@@ -0,0 +1,58 @@
+#ifndef STREAMWRITER_H
+#define STREAMWRITER_H
+
+#include "../AudioTypes.h"
+#include "../headers/AIFFHeaders.h"
+#include "../headers/WAVHeaders.h"
+#include "Container.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace sk::io {
+
+// ── Block‑wise PCM encoder for WAV / AIFF ────────────────────────────────
+// A provisional header is written on construction and patched with the
+// final sizes by close(), so the total length need not be known up front.
+class StreamWriter {
+  public:
+    StreamWriter(const std::filesystem::path &path, BitType bitType,
+                 SampleRate sampleRate, std::uint16_t numChannels);
+    ~StreamWriter();
+
+    StreamWriter(const StreamWriter &) = delete;
+    StreamWriter &operator=(const StreamWriter &) = delete;
+
+    // Append the first `frames` frames of block.  T must be the in‑memory
+    // sample type of the writer's bit depth.
+    template <typename T>
+    void write(const AudioBuffer<T> &block, std::size_t frames);
+
+    // Finalise the header.  Called by the destructor if not done already,
+    // but only an explicit call reports errors.
+    void close();
+
+    [[nodiscard]] std::uint64_t framesWritten() const noexcept {
+        return FramesWritten_;
+    }
+
+  private:
+    void writeHeader();
+
+    std::ofstream File_;
+    headers::WAV::WAVHeader WAVHeader_;
+    headers::AIFF::AIFFHeader AIFFHeader_;
+    Container Container_;
+    BitType BitType_;
+    SampleRate SampleRate_;
+    std::uint16_t NumChannels_;
+    std::size_t Width_;
+    std::uint64_t FramesWritten_{0};
+    std::vector<std::uint8_t> Raw_;
+    bool Closed_{false};
+};
+
+} // namespace sk::io
+
+#endif // STREAMWRITER_H
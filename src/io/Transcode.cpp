@@ -0,0 +1,159 @@
+#include "Transcode.h"
+
+#include "../headers/AIFFHeaders.h"
+#include "../headers/WAVHeaders.h"
+#include "../lib/PCMCodec.h"
+#include "AsyncIO.h"
+#include "Container.h"
+#include "Probe.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Payload copy through the async blocks, for when the kernel cannot do it.
+void copyBlocks(const std::filesystem::path &input, std::uint64_t inOffset,
+                const std::filesystem::path &output, std::uint64_t outOffset,
+                std::uint64_t length) {
+    sk::io::BlockReader reader(input, inOffset, length, 1);
+    sk::io::BlockWriter writer(output, outOffset);
+    for (auto block = reader.next(); !block.empty(); block = reader.next()) {
+        std::memcpy(writer.buffer().data(), block.data(), block.size());
+        writer.commit(block.size());
+    }
+    writer.finish();
+}
+
+// Byte range copy that stays inside the kernel where it can (and on
+// filesystems with reflinks, does not copy at all).
+void copyRange(const std::filesystem::path &input, std::uint64_t inOffset,
+               const std::filesystem::path &output, std::uint64_t outOffset,
+               std::uint64_t length) {
+#ifdef __linux__
+    const int in = ::open(input.c_str(), O_RDONLY | O_CLOEXEC);
+    const int out = ::open(output.c_str(), O_WRONLY | O_CLOEXEC);
+    if (in >= 0 && out >= 0) {
+        auto inPos = static_cast<loff_t>(inOffset);
+        auto outPos = static_cast<loff_t>(outOffset);
+        std::uint64_t left = length;
+        bool eof = false;
+        while (left > 0) {
+            const ssize_t n = ::copy_file_range(
+                in, &inPos, out, &outPos,
+                static_cast<std::size_t>(
+                    std::min<std::uint64_t>(left, std::size_t{1} << 30)),
+                0);
+            if (n > 0)
+                left -= static_cast<std::uint64_t>(n);
+            else if (n < 0 && errno == EINTR)
+                continue;
+            else {
+                eof = n == 0;
+                break;
+            }
+        }
+        ::close(in);
+        ::close(out);
+        if (left == 0)
+            return;
+        if (eof)
+            throw std::runtime_error("PCM payload short");
+        // EXDEV, EOPNOTSUPP, ENOSYS...: the kernel cannot copy between
+        // these files, so the rest goes through user space.  Genuine I/O
+        // errors resurface there.
+        inOffset += length - left;
+        outOffset += length - left;
+        length = left;
+    } else {
+        if (in >= 0)
+            ::close(in);
+        if (out >= 0)
+            ::close(out);
+    }
+#endif
+    copyBlocks(input, inOffset, output, outOffset, length);
+}
+
+// Payload copy with every width‑byte word reversed on the way through.
+void swapRange(const std::filesystem::path &input, std::uint64_t inOffset,
+               const std::filesystem::path &output, std::uint64_t outOffset,
+               std::uint64_t length, std::size_t width) {
+    sk::io::BlockReader reader(input, inOffset, length, width);
+    sk::io::BlockWriter writer(output, outOffset);
+    for (auto block = reader.next(); !block.empty(); block = reader.next()) {
+        sk::pcm::swapBytes(block.data(), writer.buffer().data(),
+                           block.size() / width, width);
+        writer.commit(block.size());
+    }
+    writer.finish();
+}
+
+} // namespace
+
+void sk::io::transcodeFile(const std::filesystem::path &input,
+                           const std::filesystem::path &output,
+                           endian::Endian aiffByteOrder) {
+    const ProbeInfo info = probe(input);
+    const std::uint16_t bits = bitsPerSample(info.Depth);
+    if (bits <= 8 || bits % 8 != 0 || (bits == 64 && !info.IsFloat))
+        throw std::runtime_error("unsupported depth for passthrough");
+    const std::size_t width = bits / 8;
+    const std::uint64_t dataBytes =
+        info.NumFrames * info.NumChannels * std::uint64_t{width};
+    const auto rate = static_cast<std::uint32_t>(info.Rate);
+
+    endian::Endian outOrder = endian::Endian::Little;
+    std::uint64_t outOffset;
+    {
+        std::ofstream file(output, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("create " + output.string());
+        switch (containerFor(output)) {
+        case Container::WAV: {
+            headers::WAV::WAVHeader header;
+            header.update(bits, rate, info.NumChannels, info.NumFrames,
+                          info.IsFloat);
+            header.write(file);
+            outOrder = endian::Endian::Little;
+            break;
+        }
+        case Container::AIFF: {
+            headers::AIFF::AIFFHeader header;
+            header.littleEndian = aiffByteOrder == endian::Endian::Little;
+            header.update(bits, rate, info.NumChannels, info.NumFrames,
+                          info.IsFloat);
+            header.write(file);
+            outOrder = header.byteOrder();
+            break;
+        }
+        case Container::DSF:
+            throw std::runtime_error("cannot rewrap PCM as DSF");
+        case Container::DSDIFF:
+            throw std::runtime_error("cannot rewrap PCM as DSDIFF");
+        }
+        outOffset = static_cast<std::uint64_t>(file.tellp());
+        // RIFF and IFF chunks are word aligned; placing the pad byte now
+        // also sizes the file before the payload is copied in.
+        if (dataBytes & 1) {
+            file.seekp(static_cast<std::streamoff>(outOffset + dataBytes));
+            file.put(0);
+        }
+        file.close();
+        if (!file)
+            throw std::runtime_error("header write failed " + output.string());
+    }
+
+    if (outOrder == info.ByteOrder)
+        copyRange(input, info.DataOffset, output, outOffset, dataBytes);
+    else
+        swapRange(input, info.DataOffset, output, outOffset, dataBytes,
+                  width);
+}
@@ -0,0 +1,27 @@
+#ifndef TRANSCODE_H
+#define TRANSCODE_H
+
+#include "../lib/EndianHelpers.h"
+#include <filesystem>
+
+namespace sk::io {
+
+// ── Container rewrap without decoding ────────────────────────────────────
+// Moves the PCM payload of a WAV/AIFF input into the container named by
+// the output extension at the same depth and rate.  Only a new header is
+// generated; the samples are copied as opaque words, byte‑reversed block
+// by block when the two byte orders differ and handed to copy_file_range
+// when they match.
+//
+// aiffByteOrder picks the layout of an AIFF output: Big writes plain AIFF,
+// Little writes integer PCM as AIFF‑C 'sowt' so a WAV payload can be
+// copied unchanged.  Float AIFF has no little‑endian form and is always
+// written big‑endian.  Throws on 8‑bit input, whose signedness differs
+// between the two containers.
+void transcodeFile(const std::filesystem::path &input,
+                   const std::filesystem::path &output,
+                   endian::Endian aiffByteOrder = endian::Endian::Big);
+
+} // namespace sk::io
+
+#endif // TRANSCODE_H
@@ -0,0 +1,207 @@
+#include "BufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+using sk::pool::HugePages;
+using sk::pool::PoolOptions;
+
+constexpr std::size_t kHugePage = std::size_t{2} << 20;
+
+// Every block starts with one alignment unit of bookkeeping, so release()
+// needs nothing but the pointer.
+enum class Origin : std::uint32_t { Heap, Map };
+struct alignas(sk::pool::kAlignment) Header {
+    std::size_t Bytes; // whole block, header included
+    Origin From;
+};
+static_assert(sizeof(Header) == sk::pool::kAlignment);
+
+std::mutex OptionsMutex;
+PoolOptions Options;
+std::atomic<bool> Enabled{true};
+std::atomic<std::uint64_t> Allocations{0};
+std::atomic<std::uint64_t> Reused{0};
+std::atomic<std::size_t> Parked{0};
+
+PoolOptions currentOptions() {
+    std::lock_guard lock(OptionsMutex);
+    return Options;
+}
+
+// Pooled sizes are powers of two, so there are few enough classes for a
+// flat array.
+constexpr unsigned kClasses = 64;
+unsigned sizeClass(std::size_t bytes) {
+    return static_cast<unsigned>(std::countr_zero(std::bit_ceil(bytes)));
+}
+
+Header *systemAllocate(std::size_t bytes, const PoolOptions &options) {
+#ifdef __linux__
+    if (bytes >= options.HugeThreshold) {
+        void *p = MAP_FAILED;
+        const std::size_t length = (bytes + kHugePage - 1) / kHugePage *
+                                   kHugePage;
+#ifdef MAP_HUGETLB
+        if (options.Pages == HugePages::Explicit)
+            p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+        if (p == MAP_FAILED) {
+            p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+            if (options.Pages != HugePages::Off)
+                ::madvise(p, length, MADV_HUGEPAGE);
+#endif
+        }
+        return ::new (p) Header{length, Origin::Map};
+    }
+#endif
+    void *p = ::operator new(bytes, std::align_val_t{sk::pool::kAlignment});
+    return ::new (p) Header{bytes, Origin::Heap};
+}
+
+void systemRelease(Header *header) noexcept {
+#ifdef __linux__
+    if (header->From == Origin::Map) {
+        ::munmap(header, header->Bytes);
+        return;
+    }
+#endif
+    ::operator delete(header, std::align_val_t{sk::pool::kAlignment});
+}
+
+// Parked blocks, one free list per size class.
+struct Shelf {
+    std::vector<Header *> Lists[kClasses];
+    std::size_t Bytes{0};
+
+    Header *take(unsigned cls) {
+        if (Lists[cls].empty())
+            return nullptr;
+        Header *header = Lists[cls].back();
+        Lists[cls].pop_back();
+        Bytes -= header->Bytes;
+        Parked -= header->Bytes;
+        return header;
+    }
+    bool put(Header *header, std::size_t limit) {
+        if (Bytes + header->Bytes > limit)
+            return false;
+        Lists[sizeClass(header->Bytes)].push_back(header);
+        Bytes += header->Bytes;
+        Parked += header->Bytes;
+        return true;
+    }
+    template <typename Fn> void drain(Fn &&fn) {
+        for (auto &list : Lists) {
+            for (Header *header : list) {
+                Bytes -= header->Bytes;
+                Parked -= header->Bytes;
+                fn(header);
+            }
+            list.clear();
+        }
+    }
+};
+
+// Shared between threads; only touched on an arena miss or overflow.
+struct Depot {
+    std::mutex Mutex;
+    Shelf Blocks;
+};
+Depot &depot() {
+    static Depot instance;
+    return instance;
+}
+
+struct Arena {
+    Shelf Blocks;
+
+    ~Arena() {
+        const std::size_t limit = currentOptions().DepotBytes;
+        Depot &shared = depot();
+        std::lock_guard lock(shared.Mutex);
+        Blocks.drain([&](Header *header) {
+            if (!shared.Blocks.put(header, limit))
+                systemRelease(header);
+        });
+    }
+};
+thread_local Arena LocalArena;
+
+} // namespace
+
+void sk::pool::configure(const PoolOptions &options) {
+    {
+        std::lock_guard lock(OptionsMutex);
+        Options = options;
+    }
+    Enabled = options.Enabled;
+    if (!options.Enabled)
+        trim();
+}
+
+sk::pool::PoolOptions sk::pool::options() { return currentOptions(); }
+
+sk::pool::PoolStats sk::pool::stats() {
+    return {Allocations.load(), Reused.load(), Parked.load()};
+}
+
+std::span<std::byte> sk::pool::allocate(std::size_t bytes) {
+    ++Allocations;
+    std::size_t whole = bytes + sizeof(Header);
+    Header *header = nullptr;
+    if (whole >= kMinPooled && Enabled) {
+        whole = std::bit_ceil(whole);
+        const unsigned cls = sizeClass(whole);
+        header = LocalArena.Blocks.take(cls);
+        if (!header) {
+            Depot &shared = depot();
+            std::lock_guard lock(shared.Mutex);
+            header = shared.Blocks.take(cls);
+        }
+        if (header)
+            ++Reused;
+    }
+    if (!header)
+        header = systemAllocate(whole, currentOptions());
+    return {reinterpret_cast<std::byte *>(header + 1),
+            header->Bytes - sizeof(Header)};
+}
+
+void sk::pool::release(void *block) noexcept {
+    if (!block)
+        return;
+    Header *header = static_cast<Header *>(block) - 1;
+    if (header->Bytes >= kMinPooled && Enabled &&
+        std::has_single_bit(header->Bytes)) {
+        const PoolOptions options = currentOptions();
+        if (LocalArena.Blocks.put(header, options.ArenaBytes))
+            return;
+        Depot &shared = depot();
+        std::lock_guard lock(shared.Mutex);
+        if (shared.Blocks.put(header, options.DepotBytes))
+            return;
+    }
+    systemRelease(header);
+}
+
+void sk::pool::trim() noexcept {
+    LocalArena.Blocks.drain(systemRelease);
+    Depot &shared = depot();
+    std::lock_guard lock(shared.Mutex);
+    shared.Blocks.drain(systemRelease);
+}
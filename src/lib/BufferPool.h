@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+
+namespace sk::pool {
+
+// ── Recycled memory for sample buffers ───────────────────────────────────
+// Blocks of at least kMinPooled bytes are rounded up to a power of two and,
+// when released, parked in the releasing thread's arena instead of being
+// returned to the system.  The next request of the same size class on that
+// thread gets the block back warm: no page faults, no kernel zeroing.  A
+// thread's arena is handed to a shared depot when the thread exits, so
+// short‑lived workers (sk::parallel::forEach) still feed later ones.
+// Smaller blocks go straight to the aligned global allocator.
+
+inline constexpr std::size_t kAlignment = 64;
+inline constexpr std::size_t kMinPooled = std::size_t{64} << 10;
+
+enum class HugePages {
+    Off,
+    // madvise(MADV_HUGEPAGE) on large mappings; the kernel backs them with
+    // 2 MiB pages as it can.
+    Transparent,
+    // MAP_HUGETLB from the reserved hugetlbfs pool, falling back to
+    // Transparent when the reservation runs out.
+    Explicit
+};
+
+struct PoolOptions {
+    // Off sends every block straight back to the system.
+    bool Enabled{true};
+    HugePages Pages{HugePages::Transparent};
+    // Blocks at least this large are mapped directly and may use huge
+    // pages; smaller pooled blocks come from the heap.
+    std::size_t HugeThreshold{std::size_t{2} << 20};
+    // Most a single thread's arena, and the shared depot, keep parked.
+    std::size_t ArenaBytes{std::size_t{1} << 30};
+    std::size_t DepotBytes{std::size_t{2} << 30};
+};
+
+struct PoolStats {
+    std::uint64_t Allocations{0};
+    // Allocations served from an arena or the depot.
+    std::uint64_t Reused{0};
+    // Bytes currently parked across all arenas and the depot.
+    std::size_t ParkedBytes{0};
+};
+
+// Process‑wide settings; they apply to blocks allocated from then on.
+void configure(const PoolOptions &options);
+[[nodiscard]] PoolOptions options();
+[[nodiscard]] PoolStats stats();
+
+// At least `bytes` bytes aligned to kAlignment; the span covers the whole
+// block, which may be larger.  Contents are unspecified.  Throws
+// std::bad_alloc.
+[[nodiscard]] std::span<std::byte> allocate(std::size_t bytes);
+// Give back a block from allocate(); null is ignored.
+void release(void *block) noexcept;
+// Return everything parked in this thread's arena and the depot to the
+// system.
+void trim() noexcept;
+
+// std allocator over the pool, for scratch vectors.
+template <typename T> struct Allocator {
+    using value_type = T;
+
+    Allocator() = default;
+    template <typename U> Allocator(const Allocator<U> &) noexcept {}
+
+    [[nodiscard]] T *allocate(std::size_t n) {
+        return static_cast<T *>(
+            static_cast<void *>(pool::allocate(n * sizeof(T)).data()));
+    }
+    void deallocate(T *p, std::size_t) noexcept { pool::release(p); }
+
+    template <typename U>
+    bool operator==(const Allocator<U> &) const noexcept {
+        return true;
+    }
+};
+
+} // namespace sk::pool
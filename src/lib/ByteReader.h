@@ -0,0 +1,72 @@
+#pragma once
+#include "EndianHelpers.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace sk::bytes {
+
+// ── Bounds‑checked cursor over an in‑memory byte range ───────────────────
+// Used to parse container headers straight out of a mapped file without
+// going through an iostream.  Every read advances the cursor and throws if
+// it would run past the end of the range.
+class ByteReader {
+  public:
+    ByteReader(const std::uint8_t *data, std::size_t size) noexcept
+        : Data_(data), Size_(size) {}
+
+    [[nodiscard]] std::size_t tell() const noexcept { return Pos_; }
+    [[nodiscard]] std::size_t size() const noexcept { return Size_; }
+    [[nodiscard]] std::size_t remaining() const noexcept {
+        return Size_ - Pos_;
+    }
+    [[nodiscard]] const std::uint8_t *current() const noexcept {
+        return Data_ + Pos_;
+    }
+
+    void seek(std::size_t pos) {
+        if (pos > Size_)
+            throw std::runtime_error("seek past end of buffer");
+        Pos_ = pos;
+    }
+    void skip(std::size_t n) {
+        require(n);
+        Pos_ += n;
+    }
+
+    void read(char *dst, std::size_t n) {
+        require(n);
+        std::memcpy(dst, Data_ + Pos_, n);
+        Pos_ += n;
+    }
+    // Compare the next four bytes against a chunk ID without consuming them.
+    [[nodiscard]] bool peekTag(const char (&tag)[5]) const noexcept {
+        return remaining() >= 4 && std::memcmp(Data_ + Pos_, tag, 4) == 0;
+    }
+
+    template <endian::IntWord T> [[nodiscard]] T readLE() {
+        require(sizeof(T));
+        T v = endian::load_le<T>(Data_ + Pos_);
+        Pos_ += sizeof(T);
+        return v;
+    }
+    template <endian::IntWord T> [[nodiscard]] T readBE() {
+        require(sizeof(T));
+        T v = endian::load_be<T>(Data_ + Pos_);
+        Pos_ += sizeof(T);
+        return v;
+    }
+
+  private:
+    void require(std::size_t n) const {
+        if (n > Size_ - Pos_)
+            throw std::runtime_error("unexpected end of header data");
+    }
+
+    const std::uint8_t *Data_;
+    std::size_t Size_;
+    std::size_t Pos_{0};
+};
+
+} // namespace sk::bytes
@@ -0,0 +1,73 @@
+#pragma once
+#include "Simd.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace sk::dsd {
+
+// ── 1‑bit DSD byte streams ───────────────────────────────────────────────
+// In memory SineKit keeps DSD as one byte stream per channel, eight
+// samples per byte with the oldest sample in the most significant bit (the
+// DSDIFF order).  DSF files store bits LSB first and are reversed on the
+// way in and out.
+
+// PCM full scale corresponds to 50 % modulation, the SACD reference level:
+// the modulator scales PCM by kReferenceLevel and the decimator divides by
+// it, so toDSD() followed by toPCM() keeps the level.  A stream modulated
+// harder than that decodes past full scale.
+inline constexpr double kReferenceLevel = 0.5;
+
+inline constexpr std::array<std::uint8_t, 256> kBitReverse = [] {
+    std::array<std::uint8_t, 256> table{};
+    for (unsigned v = 0; v < 256; ++v) {
+        unsigned r = 0;
+        for (unsigned b = 0; b < 8; ++b)
+            r |= ((v >> b) & 1u) << (7 - b);
+        table[v] = static_cast<std::uint8_t>(r);
+    }
+    return table;
+}();
+
+// ── Kernels, once per ISA level ──────────────────────────────────────────
+namespace base {
+#define SK_KERNEL_LEVEL SK_BUILD_LEVEL
+#include "DSDCodecKernels.inc"
+} // namespace base
+
+#if SINEKIT_SIMD_DISPATCH
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+namespace ssse3 {
+#define SK_KERNEL_LEVEL SK_LEVEL_SSSE3
+#include "DSDCodecKernels.inc"
+} // namespace ssse3
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define SK_KERNEL_LEVEL SK_LEVEL_AVX2
+#include "DSDCodecKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+#endif
+
+// Reverse the bit order of n bytes from src into dst (which may alias
+// src), with the kernel of this CPU's level.
+inline void reverseBits(const std::uint8_t *src, std::uint8_t *dst,
+                        std::size_t n) noexcept {
+    SK_SIMD_CALL(reverseBits, src, dst, n);
+}
+
+// Copy n bytes, reversing their bit order when `reverse` is set.
+inline void copyBits(const std::uint8_t *src, std::uint8_t *dst,
+                     std::size_t n, bool reverse) noexcept {
+    if (reverse)
+        reverseBits(src, dst, n);
+    else if (src != dst)
+        std::memmove(dst, src, n);
+}
+
+} // namespace sk::dsd
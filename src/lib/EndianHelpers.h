@@ -3,6 +3,7 @@
 #include <bitset>
 #include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -80,6 +81,26 @@ template <IntWord T> [[nodiscard]] inline T read_be(std::ifstream &is) {
     return be_to_host(v);
 }
 
+// ── Unaligned loads / stores on raw byte buffers (e.g. mapped files) ─────
+template <IntWord T> [[nodiscard]] inline T load_le(const void *p) noexcept {
+    T v;
+    std::memcpy(&v, p, sizeof v);
+    return le_to_host(v);
+}
+template <IntWord T> [[nodiscard]] inline T load_be(const void *p) noexcept {
+    T v;
+    std::memcpy(&v, p, sizeof v);
+    return be_to_host(v);
+}
+template <IntWord T> inline void store_le(void *p, T v) noexcept {
+    v = host_to_le(v);
+    std::memcpy(p, &v, sizeof v);
+}
+template <IntWord T> inline void store_be(void *p, T v) noexcept {
+    v = host_to_be(v);
+    std::memcpy(p, &v, sizeof v);
+}
+
 // ── Adapters for quick per‑field use in structs ───────────────────────────
 template <IntWord T>
 [[nodiscard]] constexpr T swap_if_needed(T raw, Endian fileEndian) noexcept {
@@ -0,0 +1,133 @@
+#pragma once
+#include "EndianHelpers.h"
+#include "Simd.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace sk::pcm {
+
+// ── Interleaved file bytes ⇄ planar host samples ─────────────────────────
+// Frames are processed in passes of kBlockFrames so the interleaved rows a
+// pass reads (or writes) stay cache resident while each channel is walked.
+inline constexpr std::size_t kBlockFrames = 1024;
+
+[[nodiscard]] inline std::int32_t load24(const std::uint8_t *p,
+                                         endian::Endian fileEndian) noexcept {
+    std::uint32_t v32;
+    if (fileEndian == endian::Endian::Little) {
+        v32 = (static_cast<std::uint32_t>(p[2]) << 16) |
+              (static_cast<std::uint32_t>(p[1]) << 8) |
+              (static_cast<std::uint32_t>(p[0]));
+    } else {
+        v32 = (static_cast<std::uint32_t>(p[0]) << 16) |
+              (static_cast<std::uint32_t>(p[1]) << 8) |
+              (static_cast<std::uint32_t>(p[2]));
+    }
+    // Sign‑extend bit 23 into the top byte.
+    return static_cast<std::int32_t>(v32 << 8) >> 8;
+}
+
+inline void store24(std::uint8_t *p, std::int32_t v,
+                    endian::Endian fileEndian) noexcept {
+    const auto s = static_cast<std::uint32_t>(v);
+    if (fileEndian == endian::Endian::Little) {
+        p[0] = s & 0xFF;
+        p[1] = (s >> 8) & 0xFF;
+        p[2] = (s >> 16) & 0xFF;
+    } else {
+        p[2] = s & 0xFF;
+        p[1] = (s >> 8) & 0xFF;
+        p[0] = (s >> 16) & 0xFF;
+    }
+}
+
+// True when words stored in fileEndian must be byte‑reversed for the host.
+[[nodiscard]] constexpr bool needsSwap(endian::Endian fileEndian) noexcept {
+    return (fileEndian == endian::Endian::Little) != endian::kHostIsLE;
+}
+
+// ── Kernels, once per ISA level ──────────────────────────────────────────
+namespace base {
+#define SK_KERNEL_LEVEL SK_BUILD_LEVEL
+#include "PCMCodecKernels.inc"
+} // namespace base
+
+#if SINEKIT_SIMD_DISPATCH
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+namespace ssse3 {
+#define SK_KERNEL_LEVEL SK_LEVEL_SSSE3
+#include "PCMCodecKernels.inc"
+} // namespace ssse3
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define SK_KERNEL_LEVEL SK_LEVEL_AVX2
+#include "PCMCodecKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+#endif
+
+// ── Entry points ─────────────────────────────────────────────────────────
+// Each runs the kernel of this CPU's level (see the kernel file for what
+// they do).
+
+// n packed triplets → n sign‑extended int32.
+inline void unpack24(const std::uint8_t *src, std::int32_t *dst,
+                     std::size_t n, endian::Endian fileEndian) noexcept {
+    SK_SIMD_CALL(unpack24, src, dst, n, fileEndian);
+}
+
+// n int32 → n packed triplets, keeping the low 24 bits of each word.
+inline void pack24(const std::int32_t *src, std::uint8_t *dst, std::size_t n,
+                   endian::Endian fileEndian) noexcept {
+    SK_SIMD_CALL(pack24, src, dst, n, fileEndian);
+}
+
+// Reverse every `width`‑byte word of n words from src into dst (which may
+// alias src).
+inline void swapBytes(const std::uint8_t *src, std::uint8_t *dst,
+                      std::size_t n, std::size_t width) noexcept {
+    SK_SIMD_CALL(swapBytes, src, dst, n, width);
+}
+
+// Interleaved words at src → planar dst[c][offset + f], byte‑reversed
+// when `swap` is set.
+template <typename T>
+void deinterleave(const std::uint8_t *src, T *const *dst, std::size_t offset,
+                  std::size_t frames, std::size_t ch, bool swap) noexcept {
+    SK_SIMD_CALL(deinterleave<T>, src, dst, offset, frames, ch, swap);
+}
+
+// Planar src[c][offset + f] → interleaved words at dst.
+template <typename T>
+void interleave(const T *const *src, std::size_t offset, std::uint8_t *dst,
+                std::size_t frames, std::size_t ch, bool swap) noexcept {
+    SK_SIMD_CALL(interleave<T>, src, offset, dst, frames, ch, swap);
+}
+
+// Decode `frames` interleaved frames of `width`‑byte samples into the planar
+// channel pointers dst[0 .. ch).  `width` is 3 for packed 24‑bit (T must be
+// std::int32_t) and sizeof(T) otherwise.
+template <typename T>
+void decode(const std::uint8_t *src, T *const *dst, std::size_t frames,
+            std::size_t ch, endian::Endian fileEndian, std::size_t width) {
+    SK_SIMD_CALL(decode<T>, src, dst, frames, ch, fileEndian, width);
+}
+
+// Inverse of decode(): planar host samples → interleaved file bytes.
+template <typename T>
+void encode(const T *const *src, std::uint8_t *dst, std::size_t frames,
+            std::size_t ch, endian::Endian fileEndian, std::size_t width) {
+    SK_SIMD_CALL(encode<T>, src, dst, frames, ch, fileEndian, width);
+}
+
+} // namespace sk::pcm
@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sk::parallel {
+
+namespace detail {
+// This thread's share of the machine; 0 = all of it.
+inline thread_local unsigned threadBudget = 0;
+} // namespace detail
+
+// ── Per‑thread cap on the default pool size ──────────────────────────────
+// While one is alive, forEach calls made on this thread without an
+// explicit thread count use at most `threads` workers, the caller
+// included.  A caller that already runs beside others (a batch worker, a
+// forEach item) sets its share so nested pools do not multiply into
+// threads × threads.  Scopes nest; the previous cap returns on exit.
+class ThreadBudget {
+  public:
+    explicit ThreadBudget(unsigned threads) noexcept
+        : Saved_(detail::threadBudget) {
+        detail::threadBudget = std::max(1u, threads);
+    }
+    ~ThreadBudget() { detail::threadBudget = Saved_; }
+    ThreadBudget(const ThreadBudget &) = delete;
+    ThreadBudget &operator=(const ThreadBudget &) = delete;
+
+  private:
+    unsigned Saved_;
+};
+
+// Worker count for `items` independent items: `threads` (0 = this
+// thread's ThreadBudget, or one per hardware thread without one), never
+// more than there are items.
+[[nodiscard]] inline unsigned workers(std::size_t items,
+                                      unsigned threads = 0) noexcept {
+    if (threads == 0)
+        threads = detail::threadBudget;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(
+        std::min<std::size_t>(threads, std::max<std::size_t>(items, 1)));
+}
+
+// ── Run fn(i) for every i in [0, count) on a short‑lived pool ────────────
+// Items are handed out one at a time, so uneven items balance themselves;
+// the calling thread works too.  Items run under a ThreadBudget of one,
+// so a forEach nested inside them stays on the item's thread.  Once an
+// item throws no new ones are started, and the first exception is
+// rethrown after the pool has joined.
+template <typename Fn>
+void forEach(std::size_t count, Fn &&fn, unsigned threads = 0) {
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&] {
+        const ThreadBudget serial(1);
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+                next = count;
+            }
+        }
+    };
+    {
+        const unsigned n = workers(count, threads);
+        std::vector<std::jthread> pool;
+        pool.reserve(n - 1);
+        for (unsigned t = 1; t < n; ++t)
+            pool.emplace_back(worker);
+        worker();
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace sk::parallel
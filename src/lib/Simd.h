@@ -0,0 +1,78 @@
+#pragma once
+
+// ── Vector kernels chosen at run time ────────────────────────────────────
+// Every file with intrinsic kernels keeps them in a *Kernels.inc file and
+// includes it once per ISA level, into namespaces base, ssse3 and avx2.
+// base is compiled for the build's own target; with SINEKIT_SIMD_DISPATCH
+// the other two are compiled under #pragma GCC target, and the callers
+// pick one with level(), so a default build still runs AVX2 code on a
+// machine that has it.  Elsewhere only base exists, and -march (see
+// SINEKIT_NATIVE_ARCH) decides what it contains.
+//
+// A kernel file tests SK_KERNEL_LEVEL against the levels below, never
+// __AVX2__ and friends: GCC's C++ front end lexes the whole file before
+// the target pragmas take effect, so those macros keep the build's values.
+// The includer defines SK_KERNEL_LEVEL and the kernel file undefines it.
+#define SK_LEVEL_BASE 0
+#define SK_LEVEL_SSSE3 1
+// AVX2 with FMA, as every CPU with AVX2 but a few early VIA ones has.
+#define SK_LEVEL_AVX2 2
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define SK_BUILD_LEVEL SK_LEVEL_AVX2
+#elif defined(__SSSE3__)
+#define SK_BUILD_LEVEL SK_LEVEL_SSSE3
+#else
+#define SK_BUILD_LEVEL SK_LEVEL_BASE
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define SINEKIT_SIMD_DISPATCH 1
+#else
+#define SINEKIT_SIMD_DISPATCH 0
+#endif
+
+#if SINEKIT_SIMD_DISPATCH || SK_BUILD_LEVEL > SK_LEVEL_BASE ||               \
+    defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace sk::simd {
+
+enum class Level { Base, SSSE3, AVX2 };
+
+// The level this CPU runs, detected once.  Never below what the build
+// itself targets.
+[[nodiscard]] inline Level level() noexcept {
+#if SINEKIT_SIMD_DISPATCH
+    static const Level detected = [] {
+        __builtin_cpu_init();
+        if (SK_BUILD_LEVEL == SK_LEVEL_AVX2 ||
+            (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")))
+            return Level::AVX2;
+        if (SK_BUILD_LEVEL == SK_LEVEL_SSSE3 ||
+            __builtin_cpu_supports("ssse3"))
+            return Level::SSSE3;
+        return Level::Base;
+    }();
+    return detected;
+#else
+    return Level::Base;
+#endif
+}
+
+} // namespace sk::simd
+
+// fn(args...) from the kernel namespace of level(), named relative to the
+// caller's namespace.
+#if SINEKIT_SIMD_DISPATCH
+#define SK_SIMD_CALL(fn, ...)                                                \
+    (::sk::simd::level() == ::sk::simd::Level::AVX2                          \
+         ? avx2::fn(__VA_ARGS__)                                             \
+     : ::sk::simd::level() == ::sk::simd::Level::SSSE3                       \
+         ? ssse3::fn(__VA_ARGS__)                                            \
+         : base::fn(__VA_ARGS__))
+#else
+#define SK_SIMD_CALL(fn, ...) base::fn(__VA_ARGS__)
+#endif
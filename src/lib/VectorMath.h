@@ -0,0 +1,44 @@
+#pragma once
+#include "Simd.h"
+#include <cstddef>
+
+namespace sk::vec {
+
+// ── Kernels, once per ISA level ──────────────────────────────────────────
+namespace base {
+#define SK_KERNEL_LEVEL SK_BUILD_LEVEL
+#include "VectorMathKernels.inc"
+} // namespace base
+
+#if SINEKIT_SIMD_DISPATCH
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+namespace ssse3 {
+#define SK_KERNEL_LEVEL SK_LEVEL_SSSE3
+#include "VectorMathKernels.inc"
+} // namespace ssse3
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define SK_KERNEL_LEVEL SK_LEVEL_AVX2
+#include "VectorMathKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+#endif
+
+// Dot product of two float runs whose length n is a multiple of 8, with
+// the kernel of this CPU's level.  FIR taps are zero padded to suit.
+[[nodiscard]] inline float dot(const float *a, const float *b,
+                               std::size_t n) noexcept {
+    return SK_SIMD_CALL(dot, a, b, n);
+}
+
+// Double counterpart for runs whose length n is a multiple of 4.
+[[nodiscard]] inline double dot(const double *a, const double *b,
+                                std::size_t n) noexcept {
+    return SK_SIMD_CALL(dot, a, b, n);
+}
+
+} // namespace sk::vec
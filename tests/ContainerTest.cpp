@@ -0,0 +1,303 @@
+// Round trips through every container: PCM through StreamWriter and
+// StreamReader for WAV and AIFF at each depth, transcodeFile between them
+// (AIFF‑C 'sowt' included), DSD through the DSF and DSDIFF writers and
+// readers at sample counts that are not a multiple of 8, and the RF64
+// promotion of a WAV header past 4 GiB.  probe() must agree with each file
+// written.
+
+#include "AudioTypes.h"
+#include "headers/WAVHeaders.h"
+#include "io/DSDIFFStream.h"
+#include "io/DSFStream.h"
+#include "io/Probe.h"
+#include "io/StreamReader.h"
+#include "io/StreamWriter.h"
+#include "io/Transcode.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+using sk::BitType;
+using sk::SampleRate;
+using sk::endian::Endian;
+
+constexpr std::size_t kFrames = 5001;
+
+std::mt19937_64 rng(0x5EED);
+int failures = 0;
+std::filesystem::path dir;
+
+void check(bool ok, const char *format, ...) {
+    if (ok)
+        return;
+    ++failures;
+    std::va_list args;
+    va_start(args, format);
+    std::fputs("FAIL ", stderr);
+    std::vfprintf(stderr, format, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+}
+
+// Random samples covering the whole range of depth.
+template <typename T>
+sk::AudioBuffer<T> randomPCM(BitType depth, std::size_t channels) {
+    sk::AudioBuffer<T> buffer;
+    buffer.resize(channels, kFrames);
+    for (std::size_t c = 0; c < channels; ++c) {
+        for (T &v : buffer.channel(c)) {
+            if constexpr (std::is_floating_point_v<T>)
+                v = std::uniform_real_distribution<T>(-1, 1)(rng);
+            else if (depth == BitType::I24)
+                v = static_cast<std::int32_t>(rng()) >> 8;
+            else
+                v = static_cast<T>(rng());
+        }
+    }
+    return buffer;
+}
+
+bool isFloat(BitType depth) {
+    return depth == BitType::F32 || depth == BitType::F64;
+}
+
+template <typename T>
+bool samePCM(const sk::AudioBuffer<T> &a, const sk::AudioBuffer<T> &b) {
+    if (a.numChannels() != b.numChannels() || a.numFrames() != b.numFrames())
+        return false;
+    for (std::size_t c = 0; c < a.numChannels(); ++c)
+        if (!std::equal(a.channel(c).begin(), a.channel(c).end(),
+                        b.channel(c).begin()))
+            return false;
+    return true;
+}
+
+template <typename T>
+sk::AudioBuffer<T> readPCM(const std::filesystem::path &path) {
+    sk::io::StreamReader reader(path);
+    sk::AudioBuffer<T> out;
+    reader.read(out, reader.numFrames());
+    return out;
+}
+
+void checkProbe(const std::filesystem::path &path, BitType depth,
+                SampleRate rate, std::size_t channels, std::uint64_t frames,
+                Endian order) {
+    const sk::ProbeInfo info = sk::probe(path);
+    check(info.Depth == depth && info.Rate == rate &&
+              info.NumChannels == channels && info.NumFrames == frames &&
+              info.ByteOrder == order,
+          "probe %s", path.filename().c_str());
+}
+
+// ── PCM ──────────────────────────────────────────────────────────────────
+void testPCM(BitType depth, std::size_t channels) {
+    sk::withSampleType(depth, [&]<typename T>(std::type_identity<T>) {
+        const sk::AudioBuffer<T> in = randomPCM<T>(depth, channels);
+        const std::string stem = "pcm_" +
+                                 std::to_string(sk::bitsPerSample(depth)) +
+                                 (isFloat(depth) ? "f_" : "_") +
+                                 std::to_string(channels);
+        const bool aiff = depth != BitType::I8;
+
+        const std::filesystem::path wav = dir / (stem + ".wav");
+        {
+            sk::io::StreamWriter writer(wav, depth, SampleRate::P48K,
+                                        static_cast<std::uint16_t>(channels));
+            writer.write(in, kFrames);
+            writer.close();
+        }
+        check(samePCM(readPCM<T>(wav), in), "%s.wav round trip",
+              stem.c_str());
+        checkProbe(wav, depth, SampleRate::P48K, channels, kFrames,
+                   Endian::Little);
+        // 8‑bit samples are signed in AIFF and unsigned in WAV.
+        if (!aiff)
+            return;
+
+        const std::filesystem::path plain = dir / (stem + ".aiff");
+        {
+            sk::io::StreamWriter writer(plain, depth, SampleRate::P48K,
+                                        static_cast<std::uint16_t>(channels));
+            writer.write(in, kFrames);
+            writer.close();
+        }
+        check(samePCM(readPCM<T>(plain), in), "%s.aiff round trip",
+              stem.c_str());
+        checkProbe(plain, depth, SampleRate::P48K, channels, kFrames,
+                   Endian::Big);
+
+        // WAV → AIFF‑C 'sowt' (integer only; float AIFF stays big endian)
+        // → WAV, and plain AIFF → WAV.
+        const std::filesystem::path sowt = dir / (stem + "_sowt.aiff");
+        sk::io::transcodeFile(wav, sowt, Endian::Little);
+        checkProbe(sowt, depth, SampleRate::P48K, channels, kFrames,
+                   isFloat(depth) ? Endian::Big : Endian::Little);
+        check(samePCM(readPCM<T>(sowt), in), "%s WAV → sowt",
+              stem.c_str());
+        const std::filesystem::path back = dir / (stem + "_back.wav");
+        sk::io::transcodeFile(sowt, back);
+        check(samePCM(readPCM<T>(back), in), "%s sowt → WAV",
+              stem.c_str());
+        sk::io::transcodeFile(plain, back);
+        check(samePCM(readPCM<T>(back), in), "%s AIFF → WAV",
+              stem.c_str());
+    });
+}
+
+// ── DSD ──────────────────────────────────────────────────────────────────
+// Writes `samples` samples per channel in uneven calls (all but the last a
+// multiple of 8) and reads them back whole and block by block.  DSF keeps
+// the exact count; DSDIFF only counts whole bytes and rounds it up.
+template <typename Writer, typename Reader>
+void testDSD(const char *extension, std::size_t channels,
+             std::uint64_t samples) {
+    const std::filesystem::path path =
+        dir / ("dsd_" + std::to_string(channels) + "_" +
+               std::to_string(samples) + extension);
+    sk::AudioBuffer<std::uint8_t> in;
+    in.resize(channels, (samples + 7) / 8);
+    for (std::size_t c = 0; c < channels; ++c)
+        for (std::uint8_t &b : in.channel(c))
+            b = static_cast<std::uint8_t>(rng());
+    {
+        Writer writer(path, SampleRate::DSD64,
+                      static_cast<std::uint16_t>(channels));
+        sk::AudioBuffer<std::uint8_t> part;
+        for (std::uint64_t done = 0; done < samples;) {
+            const std::uint64_t n =
+                std::min<std::uint64_t>(8 * (rng() % 5000 + 1),
+                                        samples - done);
+            part.resize(channels, (n + 7) / 8);
+            for (std::size_t c = 0; c < channels; ++c)
+                std::copy_n(in.channel(c).begin() + done / 8, (n + 7) / 8,
+                            part.channel(c).begin());
+            writer.write(part, n);
+            done += n;
+        }
+        writer.close();
+    }
+    const std::uint64_t expect =
+        std::is_same_v<Writer, sk::io::DSDIFFWriter> ? (samples + 7) / 8 * 8
+                                                    : samples;
+    checkProbe(path, BitType::D1, SampleRate::DSD64, channels, expect,
+               sk::probe(path).ByteOrder);
+
+    // Only the samples written count in the last byte.
+    const auto tail = static_cast<std::uint8_t>(
+        samples % 8 == 0 ? 0xFF : 0xFF << (8 - samples % 8));
+    auto same = [&](const sk::AudioBuffer<std::uint8_t> &out) {
+        if (out.numChannels() != channels)
+            return false;
+        for (std::size_t c = 0; c < channels; ++c) {
+            const auto a = in.channel(c);
+            const auto b = out.channel(c);
+            if (b.size() < a.size() ||
+                !std::equal(a.begin(), a.end() - 1, b.begin()) ||
+                ((a.back() ^ b[a.size() - 1]) & tail) != 0)
+                return false;
+        }
+        return true;
+    };
+
+    Reader whole(path);
+    check(whole.numSamples() == expect, "%s samples %llu",
+          path.filename().c_str(),
+          static_cast<unsigned long long>(whole.numSamples()));
+    sk::AudioBuffer<std::uint8_t> out;
+    whole.readAll(out);
+    check(same(out), "%s readAll", path.filename().c_str());
+
+    Reader blocks(path);
+    sk::AudioBuffer<std::uint8_t> all;
+    all.resize(channels, (samples + 7) / 8);
+    sk::AudioBuffer<std::uint8_t> block;
+    std::uint64_t done = 0;
+    while (const std::size_t n = blocks.read(block)) {
+        for (std::size_t c = 0; c < channels; ++c)
+            std::copy_n(block.channel(c).begin(), (n + 7) / 8,
+                        all.channel(c).begin() + done / 8);
+        done += n;
+    }
+    check(done == expect && same(all), "%s read", path.filename().c_str());
+}
+
+// ── RF64 ─────────────────────────────────────────────────────────────────
+// Only the header is written: a payload past 4 GiB is promoted to RF64 in
+// the room reserveDS64 leaves, and reads back with its 64‑bit sizes.
+void testRF64() {
+    auto header = [&](std::uint64_t frames, const char *name) {
+        sk::headers::WAV::WAVHeader h;
+        h.reserveDS64 = true;
+        h.update(24, 96000, 6, frames, false);
+        const std::filesystem::path path = dir / name;
+        {
+            std::ofstream file(path, std::ios::binary);
+            h.write(file);
+        }
+        sk::headers::WAV::WAVHeader back;
+        std::ifstream file(path, std::ios::binary);
+        back.read(file);
+        return std::pair{back, static_cast<std::uint64_t>(file.tellg())};
+    };
+    // 18 bytes a frame: 2³² / 18 frames is the last that fits.
+    const std::uint64_t small = 1000;
+    const std::uint64_t large = (std::uint64_t{1} << 32) / 18 + 1;
+    const auto [riff, riffHeader] = header(small, "small.wav");
+    const auto [rf64, rf64Header] = header(large, "large.wav");
+
+    check(!riff.isRF64() && riff.numFrames() == small,
+          "small WAV header promoted");
+    check(rf64.isRF64() && rf64.riff.ChunkSize == 0xFFFFFFFF &&
+              rf64.data.Subchunk2Size == 0xFFFFFFFF,
+          "large WAV header not promoted");
+    check(rf64.dataSize() == large * 18 && rf64.numFrames() == large &&
+              rf64.ds64.SampleCount == large,
+          "RF64 sizes %llu", static_cast<unsigned long long>(rf64.dataSize()));
+    // Promotion turns the reserved JUNK into ds64 in place.
+    check(riffHeader == rf64Header, "RF64 payload moved from %llu to %llu",
+          static_cast<unsigned long long>(riffHeader),
+          static_cast<unsigned long long>(rf64Header));
+}
+
+} // namespace
+
+int main() {
+    dir = std::filesystem::temp_directory_path() /
+          ("sinekit-test-" + std::to_string(rng()));
+    std::filesystem::create_directories(dir);
+
+    for (const BitType depth : {BitType::I8, BitType::I16, BitType::I24,
+                                BitType::I32, BitType::F32, BitType::F64})
+        for (const std::size_t channels : {1, 2, 5})
+            testPCM(depth, channels);
+    std::printf("PCM: done\n");
+
+    for (const std::size_t channels : {1, 2, 6}) {
+        // Up to several I/O blocks, and several DSF block groups each.
+        for (const std::uint64_t samples :
+             {1, 7, 8, 4096 * 8 * 3 + 5, 4096 * 8 * 100 + 3}) {
+            testDSD<sk::io::DSFWriter, sk::io::DSFReader>(".dsf", channels,
+                                                           samples);
+            testDSD<sk::io::DSDIFFWriter, sk::io::DSDIFFReader>(
+                ".dff", channels, samples);
+        }
+    }
+    std::printf("DSD: done\n");
+
+    testRF64();
+    std::printf("RF64: done\n");
+
+    std::filesystem::remove_all(dir);
+    std::printf("%d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
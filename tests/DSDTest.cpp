@@ -0,0 +1,71 @@
+// Checks the DSD level convention end to end: a sine through DSDModulator
+// and back through DSDDecimator keeps its amplitude (PCM full scale is
+// 50 % modulation both ways) and its timing: both remove their latency,
+// to within a fraction of an output sample.
+
+#include "dsp/DSDDecimator.h"
+#include "dsp/DSDModulator.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+// A `level` 1 kHz sine at pcmRate through DSD at dsdRate, decoded at
+// outRate.
+void testRoundTrip(std::uint32_t pcmRate, std::uint32_t dsdRate,
+                   std::uint32_t outRate, double level) {
+    const double f = 1000;
+    const std::uint64_t frames = pcmRate / 2;
+    std::vector<float> in(frames);
+    for (std::uint64_t k = 0; k < frames; ++k)
+        in[k] = static_cast<float>(
+            level * std::sin(2 * std::numbers::pi * f *
+                             static_cast<double>(k) / pcmRate));
+
+    sk::dsp::DSDModulator modulator(pcmRate, dsdRate);
+    const std::uint64_t samples = frames * modulator.ratio();
+    std::vector<std::uint8_t> dsd(samples / 8);
+    modulator.run(in.data(), frames, dsd.data());
+
+    sk::dsp::DSDDecimator decimator(dsdRate, outRate);
+    std::vector<float> out(samples / decimator.ratio());
+    decimator.run(dsd.data(), samples, out.data());
+
+    // Fit the sine over the middle 80 %, clear of both edges.
+    const std::size_t a = out.size() / 10;
+    const std::size_t b = out.size() - a;
+    double s = 0;
+    double c = 0;
+    for (std::size_t k = a; k < b; ++k) {
+        const double w = 2 * std::numbers::pi * f * static_cast<double>(k) /
+                         outRate;
+        s += out[k] * std::sin(w);
+        c += out[k] * std::cos(w);
+    }
+    const double amplitude = 2 * std::hypot(s, c) / static_cast<double>(b - a);
+    // Phase as a delay in output samples.
+    const double delay =
+        std::atan2(c, s) / (2 * std::numbers::pi * f) * outRate;
+    std::printf("DSD%u -> %u Hz: amplitude %.5f (sent %.5f), delay %.4f\n",
+                dsdRate / 44100, outRate, amplitude, level, delay);
+    if (std::abs(amplitude - level) > 5e-5 || std::abs(delay) > 0.25) {
+        ++failures;
+        std::fprintf(stderr, "FAIL DSD%u -> %u Hz round trip\n",
+                     dsdRate / 44100, outRate);
+    }
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip(44100, 2822400, 88200, 0.5);
+    testRoundTrip(44100, 2822400, 176400, 0.25);
+    testRoundTrip(88200, 5644800, 88200, 0.5);
+    std::printf("%d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+// Checks that Dither's output does not depend on how a signal is split into
+// process() calls: whole signals and the same signals fed in uneven blocks
+// must give identical words, for every noise shaping and for channel counts
+// that fill and that leave part of a lane group.
+
+#include "dsp/Dither.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using sk::BitType;
+using sk::NoiseShaping;
+
+constexpr std::size_t kFrames = 5000;
+// Around the 256‑frame inner blocks, and primes.
+constexpr std::size_t kSplits[] = {1, 7, 255, 256, 257, 509, 1024, 3};
+
+std::mt19937_64 rng(0x5EED);
+int failures = 0;
+
+const char *name(NoiseShaping shaping) {
+    switch (shaping) {
+    case NoiseShaping::None:
+        return "flat";
+    case NoiseShaping::FirstOrder:
+        return "first order";
+    case NoiseShaping::EWeighted:
+        return "E‑weighted";
+    default:
+        return "F‑weighted";
+    }
+}
+
+template <typename From, typename To>
+void testSplits(NoiseShaping shaping, std::size_t channels, BitType from,
+                BitType to, const std::vector<std::vector<From>> &in) {
+    auto run = [&](bool split) {
+        sk::dsp::Dither dither(sk::DitherAmount::Medium, shaping, channels,
+                               7);
+        std::vector<std::vector<To>> out(channels, std::vector<To>(kFrames));
+        std::size_t clipped = 0;
+        std::size_t s = 0;
+        for (std::size_t done = 0; done < kFrames;) {
+            const std::size_t n =
+                split ? std::min(kSplits[s++ % std::size(kSplits)],
+                                 kFrames - done)
+                      : kFrames;
+            std::vector<const From *> src(channels);
+            std::vector<To *> dst(channels);
+            for (std::size_t c = 0; c < channels; ++c) {
+                src[c] = in[c].data() + done;
+                dst[c] = out[c].data() + done;
+            }
+            clipped += dither.process(src.data(), dst.data(), n, from, to);
+            done += n;
+        }
+        return std::pair{out, clipped};
+    };
+    const auto whole = run(false);
+    const auto split = run(true);
+    if (whole != split) {
+        ++failures;
+        std::fprintf(stderr, "FAIL %s, %zu channels: split output differs\n",
+                     name(shaping), channels);
+    }
+}
+
+} // namespace
+
+int main() {
+    for (const std::size_t channels : {1, 4, 6}) {
+        // Float input slightly past full scale, so clipping is counted too.
+        std::uniform_real_distribution<float> level(-1.05f, 1.05f);
+        std::vector<std::vector<float>> floats(channels,
+                                               std::vector<float>(kFrames));
+        std::vector<std::vector<std::int32_t>> ints(
+            channels, std::vector<std::int32_t>(kFrames));
+        for (std::size_t c = 0; c < channels; ++c) {
+            for (float &v : floats[c])
+                v = level(rng);
+            for (std::int32_t &v : ints[c])
+                v = static_cast<std::int32_t>(rng());
+        }
+        for (const NoiseShaping shaping :
+             {NoiseShaping::None, NoiseShaping::FirstOrder,
+              NoiseShaping::EWeighted, NoiseShaping::FWeighted}) {
+            testSplits<float, std::int16_t>(shaping, channels, BitType::F32,
+                                            BitType::I16, floats);
+            testSplits<std::int32_t, std::int32_t>(
+                shaping, channels, BitType::I32, BitType::I24, ints);
+        }
+    }
+    std::printf("dither: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// Checks FFT against the DFT's definition and OverlapSave against the
+// direct dot products it replaces.  The transform runs the butterfly
+// kernels of this CPU's ISA level (see lib/Simd.h).
+
+#include "dsp/FFT.h"
+#include "dsp/OverlapSave.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdarg>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Complex = std::complex<double>;
+
+std::mt19937_64 rng(0x5EED);
+int failures = 0;
+
+void check(bool ok, const char *format, ...) {
+    if (ok)
+        return;
+    ++failures;
+    std::va_list args;
+    va_start(args, format);
+    std::fputs("FAIL ", stderr);
+    std::vfprintf(stderr, format, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+}
+
+double uniform() {
+    return std::uniform_real_distribution<double>(-1.0, 1.0)(rng);
+}
+
+std::vector<Complex> randomComplex(std::size_t n) {
+    std::vector<Complex> x(n);
+    for (Complex &v : x)
+        v = {uniform(), uniform()};
+    return x;
+}
+
+// Largest |a − b| over the largest |b|.
+double relativeError(const std::vector<Complex> &a,
+                     const std::vector<Complex> &b) {
+    double error = 0;
+    double scale = 0;
+    for (std::size_t k = 0; k < a.size(); ++k) {
+        error = std::max(error, std::abs(a[k] - b[k]));
+        scale = std::max(scale, std::abs(b[k]));
+    }
+    return error / scale;
+}
+
+// ── FFT ──────────────────────────────────────────────────────────────────
+void testFFT() {
+    // Every size up to the vector kernels' widest stage and past it.
+    for (std::size_t size = 1; size <= 4096; size *= 2) {
+        const sk::dsp::FFT fft(size);
+        const std::vector<Complex> x = randomComplex(size);
+
+        // X[k] = Σ x[n] e^(−2πi nk / N), with nk reduced mod N exactly.
+        const double w = -2 * std::numbers::pi / static_cast<double>(size);
+        std::vector<Complex> expect(size);
+        for (std::size_t k = 0; k < size; ++k)
+            for (std::size_t n = 0; n < size; ++n)
+                expect[k] += x[n] * std::polar(1.0, w * static_cast<double>(
+                                                            n * k % size));
+        std::vector<Complex> y = x;
+        fft.forward(y.data());
+        const double forward = relativeError(y, expect);
+        check(forward < 1e-13, "FFT %zu forward error %g", size, forward);
+
+        // The inverse is unscaled: inverse(forward(x)) = N x.
+        fft.inverse(y.data());
+        for (Complex &v : y)
+            v /= static_cast<double>(size);
+        const double roundTrip = relativeError(y, x);
+        check(roundTrip < 1e-14, "FFT %zu round trip error %g", size,
+              roundTrip);
+        if (size == 4096)
+            std::printf("FFT 4096: forward %.1e, round trip %.1e\n", forward,
+                        roundTrip);
+    }
+}
+
+// ── OverlapSave ──────────────────────────────────────────────────────────
+void testOverlapSave() {
+    for (const std::size_t filters : {1, 2, 5}) {
+        for (const std::size_t taps : {1, 2, 7, 64, 301, 2048}) {
+            std::vector<double> h(filters * taps);
+            for (double &v : h)
+                v = uniform();
+            const sk::dsp::OverlapSave bank(h, taps);
+            check(bank.filters() == filters && bank.step() > 0,
+                  "OverlapSave %zu × %zu shape", filters, taps);
+
+            std::vector<double> in(bank.span());
+            for (double &v : in)
+                v = uniform();
+            std::vector<double> out(filters * bank.step());
+            std::vector<Complex> work(bank.workspace());
+            bank.run(in.data(), out.data(), work.data());
+
+            // out[f × step() + t] = Σ_j h_f[j] in[t + j], to within the
+            // rounding of sums of `taps` products.
+            double error = 0;
+            for (std::size_t f = 0; f < filters; ++f) {
+                for (std::size_t t = 0; t < bank.step(); ++t) {
+                    double dot = 0;
+                    for (std::size_t j = 0; j < taps; ++j)
+                        dot += h[f * taps + j] * in[t + j];
+                    error = std::max(
+                        error, std::abs(out[f * bank.step() + t] - dot));
+                }
+            }
+            check(error < 1e-12 * static_cast<double>(taps),
+                  "OverlapSave %zu × %zu error %g", filters, taps, error);
+        }
+    }
+    std::printf("overlap-save: done\n");
+}
+
+} // namespace
+
+int main() {
+    testFFT();
+    testOverlapSave();
+    std::printf("%d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+// Checks the PCM codec kernels of every ISA level this machine runs
+// (base, SSSE3, AVX2; see lib/Simd.h) against a byte‑by‑byte reference,
+// then the dispatching entry points.  All of them must agree with the
+// reference bit for bit.
+
+#include "lib/PCMCodec.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using sk::endian::Endian;
+
+constexpr std::size_t kMaxLength = 200;
+constexpr std::size_t kChannels[] = {1, 2, 3, 4, 5, 6, 7, 8};
+constexpr std::uint8_t kGuard = 0xA5;
+
+std::mt19937_64 rng(0x5EED);
+int failures = 0;
+const char *level = "";
+
+// One level's kernels.
+template <typename T>
+using Decode = void (*)(const std::uint8_t *, T *const *, std::size_t,
+                        std::size_t, Endian, std::size_t);
+template <typename T>
+using Encode = void (*)(const T *const *, std::uint8_t *, std::size_t,
+                        std::size_t, Endian, std::size_t);
+
+struct Kernels {
+    const char *Name;
+    void (*Unpack24)(const std::uint8_t *, std::int32_t *, std::size_t,
+                     Endian) noexcept;
+    void (*Pack24)(const std::int32_t *, std::uint8_t *, std::size_t,
+                   Endian) noexcept;
+    Decode<std::uint8_t> Decode8;
+    Encode<std::uint8_t> Encode8;
+    Decode<std::int16_t> Decode16;
+    Encode<std::int16_t> Encode16;
+    Decode<std::int32_t> Decode32;
+    Encode<std::int32_t> Encode32;
+    Decode<std::int64_t> Decode64;
+    Encode<std::int64_t> Encode64;
+};
+
+#define SK_KERNELS(name, ns)                                                 \
+    Kernels {                                                                \
+        name, ns::unpack24, ns::pack24, ns::decode<std::uint8_t>,            \
+            ns::encode<std::uint8_t>, ns::decode<std::int16_t>,              \
+            ns::encode<std::int16_t>, ns::decode<std::int32_t>,              \
+            ns::encode<std::int32_t>, ns::decode<std::int64_t>,              \
+            ns::encode<std::int64_t>                                         \
+    }
+
+const char *name(Endian e) {
+    return e == Endian::Little ? "LE" : "BE";
+}
+
+void fail(const char *what, std::size_t width, std::size_t ch,
+          std::size_t frames, Endian e) {
+    if (++failures <= 20)
+        std::fprintf(stderr,
+                     "FAIL %s %s width %zu ch %zu frames %zu %s\n", level,
+                     what, width, ch, frames, name(e));
+}
+
+std::vector<std::uint8_t> randomBytes(std::size_t n) {
+    std::vector<std::uint8_t> bytes(n);
+    for (std::uint8_t &b : bytes)
+        b = static_cast<std::uint8_t>(rng());
+    return bytes;
+}
+
+// The `width` bytes at p read in file order, as the low bits of a word;
+// 24‑bit words are sign‑extended from bit 23.
+std::uint64_t referenceLoad(const std::uint8_t *p, std::size_t width,
+                            Endian e) {
+    std::uint64_t v = 0;
+    for (std::size_t b = 0; b < width; ++b) {
+        const std::size_t at = e == Endian::Little ? b : width - 1 - b;
+        v |= static_cast<std::uint64_t>(p[at]) << (8 * b);
+    }
+    if (width == 3 && (v & 0x800000))
+        v |= 0xFFFFFF000000;
+    return v;
+}
+
+void referenceStore(std::uint8_t *p, std::uint64_t v, std::size_t width,
+                    Endian e) {
+    for (std::size_t b = 0; b < width; ++b) {
+        const std::size_t at = e == Endian::Little ? b : width - 1 - b;
+        p[at] = static_cast<std::uint8_t>(v >> (8 * b));
+    }
+}
+
+template <typename T> std::uint64_t bitsOf(T v) {
+    std::make_unsigned_t<T> u;
+    std::memcpy(&u, &v, sizeof v);
+    return u;
+}
+
+template <typename T> T fromBits(std::uint64_t v) {
+    T t;
+    const auto u = static_cast<std::make_unsigned_t<T>>(v);
+    std::memcpy(&t, &u, sizeof t);
+    return t;
+}
+
+// ── Bulk 24‑bit kernels ──
+void testPack24(const Kernels &k, Endian e) {
+    for (std::size_t n = 0; n < kMaxLength; ++n) {
+        const std::vector<std::uint8_t> packed = randomBytes(3 * n);
+        std::vector<std::int32_t> words(n + 1, 0x5A5A5A5A);
+        k.Unpack24(packed.data(), words.data(), n, e);
+        bool ok = words[n] == 0x5A5A5A5A;
+        for (std::size_t i = 0; i < n; ++i)
+            ok &= bitsOf(words[i]) ==
+                  (referenceLoad(&packed[3 * i], 3, e) & 0xFFFFFFFF);
+        if (!ok)
+            fail("unpack24", 3, 1, n, e);
+
+        std::vector<std::int32_t> in(n);
+        for (std::int32_t &v : in)
+            v = static_cast<std::int32_t>(rng());
+        std::vector<std::uint8_t> out(3 * n + 16, kGuard);
+        k.Pack24(in.data(), out.data(), n, e);
+        std::vector<std::uint8_t> expect(3 * n + 16, kGuard);
+        for (std::size_t i = 0; i < n; ++i)
+            referenceStore(&expect[3 * i], bitsOf(in[i]), 3, e);
+        if (out != expect)
+            fail("pack24", 3, 1, n, e);
+    }
+}
+
+// ── Interleaved bytes ⇄ planar words ──
+// T is the host word; `width` is sizeof(T), or 3 for packed 24‑bit.
+template <typename T>
+void testCodec(Decode<T> decode, Encode<T> encode, std::size_t width,
+               Endian e) {
+    for (const std::size_t ch : kChannels) {
+        for (std::size_t frames = 0; frames < kMaxLength; ++frames) {
+            const std::size_t bytes = frames * ch * width;
+            const std::uint64_t mask =
+                ~std::uint64_t{0} >> (64 - 8 * sizeof(T));
+
+            // Decode into planes one word longer than needed; the extra
+            // word must survive.
+            const std::vector<std::uint8_t> src = randomBytes(bytes);
+            std::vector<std::vector<T>> planes(
+                ch, std::vector<T>(frames + 1, fromBits<T>(0x5A)));
+            std::vector<T *> dst(ch);
+            for (std::size_t c = 0; c < ch; ++c)
+                dst[c] = planes[c].data();
+            decode(src.data(), dst.data(), frames, ch, e, width);
+            bool ok = true;
+            for (std::size_t c = 0; c < ch; ++c) {
+                ok &= bitsOf(planes[c][frames]) == 0x5A;
+                for (std::size_t f = 0; f < frames; ++f) {
+                    const std::uint8_t *word = &src[(f * ch + c) * width];
+                    ok &= bitsOf(planes[c][f]) ==
+                          (referenceLoad(word, width, e) & mask);
+                }
+            }
+            if (!ok)
+                fail("decode", width, ch, frames, e);
+
+            // Encode random planes; bytes past the payload must survive.
+            std::vector<const T *> in(ch);
+            for (std::size_t c = 0; c < ch; ++c) {
+                for (T &v : planes[c])
+                    v = fromBits<T>(rng());
+                in[c] = planes[c].data();
+            }
+            std::vector<std::uint8_t> out(bytes + 16, kGuard);
+            encode(in.data(), out.data(), frames, ch, e, width);
+            std::vector<std::uint8_t> expect(bytes + 16, kGuard);
+            for (std::size_t c = 0; c < ch; ++c)
+                for (std::size_t f = 0; f < frames; ++f)
+                    referenceStore(&expect[(f * ch + c) * width],
+                                   bitsOf(planes[c][f]), width, e);
+            if (out != expect)
+                fail("encode", width, ch, frames, e);
+        }
+    }
+}
+
+void testLevel(const Kernels &k) {
+    level = k.Name;
+    const int before = failures;
+    for (const Endian e : {Endian::Little, Endian::Big}) {
+        testPack24(k, e);
+        testCodec(k.Decode8, k.Encode8, 1, e);
+        testCodec(k.Decode16, k.Encode16, 2, e);
+        testCodec(k.Decode32, k.Encode32, 3, e);
+        testCodec(k.Decode32, k.Encode32, 4, e);
+        testCodec(k.Decode64, k.Encode64, 8, e);
+    }
+    std::printf("%s kernels: %d failures\n", k.Name, failures - before);
+}
+
+} // namespace
+
+int main() {
+    testLevel(SK_KERNELS("base", sk::pcm::base));
+#if SINEKIT_SIMD_DISPATCH
+    // A level this machine cannot run is skipped.
+    if (__builtin_cpu_supports("ssse3"))
+        testLevel(SK_KERNELS("SSSE3", sk::pcm::ssse3));
+    else
+        std::printf("SSSE3 kernels: skipped\n");
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        testLevel(SK_KERNELS("AVX2", sk::pcm::avx2));
+    else
+        std::printf("AVX2 kernels: skipped\n");
+#endif
+    testLevel(SK_KERNELS("dispatched", sk::pcm));
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,383 @@
+// Checks the resampling chain: the Kaiser design helpers, Resampler (both
+// the direct polyphase form and the FFT bank) against a zero‑stuffing
+// reference, the accuracy resamplingSpec promises, and FilterCache
+// save / load.
+
+#include "dsp/FFT.h"
+#include "dsp/FilterCache.h"
+#include "dsp/FilterDesign.h"
+#include "dsp/Resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using sk::dsp::FilterSpec;
+using sk::dsp::Resampler;
+
+std::mt19937_64 rng(0x5EED);
+int failures = 0;
+
+void check(bool ok, const char *format, ...) {
+    if (ok)
+        return;
+    ++failures;
+    std::va_list args;
+    va_start(args, format);
+    std::fputs("FAIL ", stderr);
+    std::vfprintf(stderr, format, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+}
+
+std::vector<double> randomSignal(std::size_t n) {
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> x(n);
+    for (double &v : x)
+        v = uniform(rng);
+    return x;
+}
+
+bool throws(auto &&fn) {
+    try {
+        fn();
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+double decibels(double ratio) { return 20 * std::log10(ratio); }
+
+// |H(f)| of an FIR at f = k / size cycles per sample, k ≤ size / 2.
+std::vector<double> response(const std::vector<double> &h, std::size_t size) {
+    std::vector<std::complex<double>> spectrum(size);
+    for (std::size_t k = 0; k < h.size(); ++k)
+        spectrum[k % size] += h[k];
+    sk::dsp::FFT(size).forward(spectrum.data());
+    std::vector<double> magnitude(size / 2 + 1);
+    for (std::size_t k = 0; k < magnitude.size(); ++k)
+        magnitude[k] = std::abs(spectrum[k]);
+    return magnitude;
+}
+
+// Largest |H(f)| − offset over [from, to] of a response() of `size`.
+double peak(const std::vector<double> &magnitude, std::size_t size,
+            double from, double to, double offset = 0) {
+    double most = 0;
+    for (std::size_t k = 0; k < magnitude.size(); ++k) {
+        const double f = static_cast<double>(k) / static_cast<double>(size);
+        if (f >= from && f <= to)
+            most = std::max(most, std::abs(magnitude[k] - offset));
+    }
+    return most;
+}
+
+// A random linear phase prototype: the reference does not care what the
+// filter does.
+std::vector<double> randomPrototype(std::size_t length) {
+    std::vector<double> h = randomSignal(length);
+    for (std::size_t k = 0; k < length / 2; ++k)
+        h[length - 1 - k] = h[k];
+    return h;
+}
+
+// Resampling by its definition: output k is the prototype, centred on
+// stuffed sample kM, over the input zero stuffed by L.
+std::vector<double> reference(const std::vector<double> &x, std::size_t up,
+                              std::size_t down,
+                              const std::vector<double> &h) {
+    const auto c = static_cast<std::ptrdiff_t>(h.size() / 2);
+    std::vector<double> y((x.size() * up + down - 1) / down);
+    for (std::size_t k = 0; k < y.size(); ++k) {
+        const auto centre = static_cast<std::ptrdiff_t>(k * down);
+        // Taps run from the newest input in reach down to t = 0.
+        const std::ptrdiff_t oldest =
+            centre + c - static_cast<std::ptrdiff_t>(h.size() - 1);
+        for (std::size_t n = oldest > 0 ? (oldest + up - 1) / up : 0;
+             n < x.size(); ++n) {
+            const std::ptrdiff_t t =
+                centre + c - static_cast<std::ptrdiff_t>(n * up);
+            if (t < 0)
+                break;
+            y[k] += h[t] * x[n];
+        }
+    }
+    return y;
+}
+
+// ── Kaiser design ────────────────────────────────────────────────────────
+void testDesign() {
+    // Kaiser's formulas, β for A > 50 dB and 21 < A ≤ 50 dB.
+    check(std::abs(sk::dsp::kaiserBeta(100) - 0.1102 * (100 - 8.7)) < 1e-12,
+          "kaiserBeta(100)");
+    check(std::abs(sk::dsp::kaiserBeta(40) -
+                   (0.5842 * std::pow(19.0, 0.4) + 0.07886 * 19)) < 1e-12,
+          "kaiserBeta(40)");
+
+    for (const double attenuation : {60.0, 100.0, 140.0}) {
+        const double cutoff = 0.2;
+        const double width = 0.05;
+        const std::size_t length =
+            sk::dsp::kaiserLength(attenuation, width) / 2 * 2 + 1;
+        const std::vector<double> h =
+            sk::dsp::kaiserLowpass(length, cutoff, attenuation);
+        check(h.size() == length, "kaiserLowpass length");
+
+        double dc = 0;
+        bool symmetric = true;
+        for (std::size_t k = 0; k < h.size(); ++k) {
+            dc += h[k];
+            symmetric &= h[k] == h[h.size() - 1 - k];
+        }
+        check(std::abs(dc - 1) < 1e-12, "kaiserLowpass %g dB DC gain %.15f",
+              attenuation, dc);
+        check(symmetric, "kaiserLowpass %g dB not linear phase", attenuation);
+
+        // Kaiser's length estimate lands within a few dB of the target.
+        const std::size_t size = 1 << 16;
+        const std::vector<double> magnitude = response(h, size);
+        const double stop = peak(magnitude, size, cutoff + width / 2, 0.5);
+        check(decibels(stop) < -attenuation + 3,
+              "kaiserLowpass %g dB stopband at %.1f dB", attenuation,
+              decibels(stop));
+        const double ripple = peak(magnitude, size, 0, cutoff - width / 2, 1);
+        check(decibels(ripple) < -attenuation + 3,
+              "kaiserLowpass %g dB passband ripple at %.1f dB", attenuation,
+              decibels(ripple));
+    }
+
+    // Invalid specs are refused.
+    const FilterSpec spec =
+        sk::dsp::resamplingSpec(2, 1, sk::ResampleQuality::Standard);
+    FilterSpec even = spec;
+    even.Taps += 1;
+    FilterSpec stuck = spec;
+    stuck.Up = 0;
+    FilterSpec flat = spec;
+    flat.Spacing = std::nan("");
+    for (const FilterSpec &invalid : {even, stuck, flat}) {
+        check(!invalid.valid(), "invalid spec accepted");
+        check(throws([&] { (void)sk::dsp::designPrototype(invalid); }),
+              "designPrototype accepted an invalid spec");
+    }
+    std::printf("filter design: done\n");
+}
+
+// ── Resampler against the reference ─────────────────────────────────────
+// Returns whether the FFT bank ran.
+bool testAgainstReference(std::size_t up, std::size_t down,
+                          std::size_t length) {
+    const std::vector<double> h = randomPrototype(length);
+    const Resampler resampler(up, down, h);
+    double scale = 0;
+    for (const double v : h)
+        scale += std::abs(v);
+
+    // Lengths shorter than the filter exercise both edges at once.
+    for (const std::size_t n : {1, 2, 3, 7, 64, 999, 4000}) {
+        const std::vector<double> x = randomSignal(n);
+        std::vector<double> y(resampler.outputLength(n));
+        check(y.size() == (n * up + down - 1) / down, "outputLength");
+        resampler.run(x.data(), n, y.data());
+        const std::vector<double> expect = reference(x, up, down, h);
+        double error = 0;
+        for (std::size_t k = 0; k < y.size(); ++k)
+            error = std::max(error, std::abs(y[k] - expect[k]));
+        check(error <= 1e-12 * scale,
+              "%zu/%zu %zu taps, %zu samples: error %g", up, down, length, n,
+              error / scale);
+    }
+    return resampler.usesFFT();
+}
+
+void testResampler() {
+    // Ratios with one phase, all of them, and gcd(L, M) > 1 leaving some
+    // out; prototypes shorter than L, centres off the input grid, and long
+    // phases, which the FFT bank takes over.
+    const std::size_t ratios[][2] = {{1, 1},   {2, 1},     {1, 2},
+                                     {3, 2},   {2, 3},     {4, 6},
+                                     {6, 4},   {160, 147}, {147, 160}};
+    std::size_t direct = 0;
+    std::size_t fft = 0;
+    auto count = [&](bool usedFFT) { ++(usedFFT ? fft : direct); };
+    for (const auto &[up, down] : ratios)
+        for (const std::size_t length : {1, 3, 25, 161, 481})
+            count(testAgainstReference(up, down, length));
+    count(testAgainstReference(1, 1, 2049));
+    count(testAgainstReference(4, 1, 4 * 4096 + 1));
+    count(testAgainstReference(1, 4, 8193));
+    count(testAgainstReference(3, 2, 3 * 2048 + 1));
+    check(direct > 0 && fft > 0, "%zu direct and %zu FFT resamplers", direct,
+          fft);
+
+    // Zero crossings on the input samples pass them through: unchanged in
+    // the direct form, and to within rounding, which integer samples
+    // absorb, in the FFT bank.
+    for (const std::uint32_t taps : {4 * 8 + 1, 4 * 64 + 1}) {
+        FilterSpec spec;
+        spec.Up = 4;
+        spec.Taps = taps;
+        spec.Beta = 10;
+        spec.Spacing = 4;
+        const Resampler upsampler(4, 1, sk::dsp::designPrototype(spec));
+        std::vector<double> x(1000);
+        for (double &v : x)
+            v = static_cast<double>(static_cast<std::int32_t>(rng()) >> 8);
+        std::vector<double> y(upsampler.outputLength(x.size()));
+        upsampler.run(x.data(), x.size(), y.data());
+        bool unchanged = true;
+        bool rounded = true;
+        for (std::size_t n = 0; n < x.size(); ++n) {
+            unchanged &= y[4 * n] == x[n];
+            rounded &= std::nearbyint(y[4 * n]) == x[n];
+        }
+        check(upsampler.usesFFT() ? rounded : unchanged,
+              "4x upsample, %u taps, FFT %d: input samples changed", taps,
+              upsampler.usesFFT());
+    }
+    std::printf("resampler: done\n");
+}
+
+// ── Accuracy of the resampling specs ─────────────────────────────────────
+// A 1 kHz sine from 44.1 to 48 kHz and back, against the exact sine away
+// from the edges.
+void testAccuracy(sk::ResampleQuality quality, double limit) {
+    const char *name =
+        quality == sk::ResampleQuality::High ? "High" : "Standard";
+    for (const auto &[from, to] : {std::pair{44100.0, 48000.0},
+                                   std::pair{48000.0, 44100.0}}) {
+        const std::size_t g = std::gcd(static_cast<std::size_t>(from),
+                                       static_cast<std::size_t>(to));
+        const std::size_t up = static_cast<std::size_t>(to) / g;
+        const std::size_t down = static_cast<std::size_t>(from) / g;
+        const FilterSpec spec = sk::dsp::resamplingSpec(up, down, quality);
+        const Resampler resampler(up, down, sk::dsp::designPrototype(spec));
+
+        auto sine = [](std::size_t k, double rate) {
+            return std::sin(2 * std::numbers::pi * 1000 *
+                            static_cast<double>(k) / rate);
+        };
+        const std::size_t n = 48000;
+        std::vector<double> x(n);
+        for (std::size_t k = 0; k < n; ++k)
+            x[k] = sine(k, from);
+        std::vector<double> y(resampler.outputLength(n));
+        resampler.run(x.data(), n, y.data());
+
+        const std::size_t edge = spec.Taps / up + 16;
+        double error = 0;
+        for (std::size_t k = edge; k + edge < y.size(); ++k)
+            error = std::max(error, std::abs(y[k] - sine(k, to)));
+        check(decibels(error) < limit, "%s %g -> %g: error %.1f dB", name,
+              from, to, decibels(error));
+        std::printf("%s %g -> %g: error %.1f dB\n", name, from, to,
+                    decibels(error));
+    }
+
+    // Everything at or above half the lower rate is attenuated by the
+    // spec's figure, give or take Kaiser's estimate, relative to the
+    // passband gain L.
+    const FilterSpec spec = sk::dsp::resamplingSpec(160, 147, quality);
+    const std::vector<double> h = sk::dsp::designPrototype(spec);
+    const std::size_t size = 1 << 20;
+    const double stop = peak(response(h, size), size, 0.5 / 160, 0.5) / 160;
+    const double attenuation =
+        quality == sk::ResampleQuality::High ? 140 : 100;
+    check(decibels(stop) < -attenuation + 4, "%s stopband at %.1f dB", name,
+          decibels(stop));
+}
+
+// ── FilterCache ──────────────────────────────────────────────────────────
+void testCache() {
+    sk::dsp::FilterCache &cache = sk::dsp::FilterCache::instance();
+    cache.clear();
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() /
+        ("sinekit-test-" + std::to_string(rng()));
+    std::filesystem::create_directories(dir);
+    const std::filesystem::path path = dir / "filters.bin";
+
+    const FilterSpec a =
+        sk::dsp::resamplingSpec(160, 147, sk::ResampleQuality::Standard);
+    const FilterSpec b =
+        sk::dsp::resamplingSpec(1, 2, sk::ResampleQuality::High);
+    const auto designed = cache.resampler(a);
+    check(cache.resampler(a) == designed, "cache designed a spec twice");
+    (void)cache.resampler(b);
+    check(cache.size() == 2, "cache size %zu", cache.size());
+
+    FilterSpec invalid = a;
+    invalid.Taps += 1;
+    check(throws([&] { (void)cache.resampler(invalid); }),
+          "cache accepted an invalid spec");
+    check(cache.size() == 2, "invalid spec entered the cache");
+
+    const std::vector<double> x = randomSignal(5000);
+    std::vector<double> before(designed->outputLength(x.size()));
+    designed->run(x.data(), x.size(), before.data());
+
+    cache.save(path);
+    cache.clear();
+    check(cache.load(path) == 2, "load did not add both entries");
+    check(cache.load(path) == 0, "load added entries twice");
+    const auto loaded = cache.resampler(a);
+    check(loaded != designed, "load kept the old design");
+    std::vector<double> after(loaded->outputLength(x.size()));
+    loaded->run(x.data(), x.size(), after.data());
+    check(after == before, "loaded filter differs from the designed one");
+
+    // A damaged file adds nothing.
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto damaged = [&](const std::vector<char> &contents) {
+        const std::filesystem::path bad = dir / "damaged.bin";
+        std::ofstream(bad, std::ios::binary)
+            .write(contents.data(), static_cast<std::streamsize>(
+                                        contents.size()));
+        cache.clear();
+        const bool threw = throws([&] { (void)cache.load(bad); });
+        return threw && cache.size() == 0;
+    };
+    std::vector<char> magic = bytes;
+    magic[0] = 'X';
+    check(damaged(magic), "loaded a file with the wrong magic");
+    // The first entry's Taps, made even.
+    std::vector<char> evenTaps = bytes;
+    evenTaps[20] ^= 1;
+    check(damaged(evenTaps), "loaded an invalid spec");
+    check(damaged({bytes.begin(), bytes.end() - 8}),
+          "loaded a truncated file");
+
+    cache.clear();
+    std::filesystem::remove_all(dir);
+    std::printf("filter cache: done\n");
+}
+
+} // namespace
+
+int main() {
+    testDesign();
+    testResampler();
+    testAccuracy(sk::ResampleQuality::Standard, -115);
+    testAccuracy(sk::ResampleQuality::High, -160);
+    testCache();
+    std::printf("%d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}